@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 PhotonicFusion LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *
+ * @file        Bus.cpp
+ * @summary     I2C bus arbitration between audio, RTC and LEDs
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include <Arduino.h>
+#include "Bus.h"
+
+/* === Arbitration ===
+
+ nI2C serves transactions in submission order, so priority is enforced
+ at submission: a class about to submit marks itself pending and lower
+ priority classes are refused until its transaction is queued
+
+ Audio marks pending once a channel reaches the refill point of its
+ ring, shortly before the next block read is due, and clears it when
+ that read is queued. Frames submitted meanwhile would delay the read
+
+ The main loop requests the bus before reading the RTC. Refused, it
+ skips that refresh and marks pending so frames wait for the next one
+
+ A flag is stamped when marked. One held longer than BUS_PENDING_TIMEOUT
+ (song stopped mid-block) is released
+=============================*/
+
+// Pending flags and counters are shared with audio interrupt context
+static volatile uint8_t g_bus_pending = 0;
+static volatile uint16_t g_bus_stamp[BUS_PRIORITY_COUNT]; // millis() when marked
+static volatile uint16_t g_bus_count[BUS_PRIORITY_COUNT][BUS_COUNTER_COUNT];
+
+
+// Mark class as about to submit a transaction - call on change, not per token
+void BusPending(const uint8_t priority, const bool pending)
+{
+    uint16_t stamp = millis();
+    uint8_t sreg = SREG;
+    cli();
+    
+    if (pending)
+    {
+        g_bus_pending |= (1 << priority);
+        g_bus_stamp[priority] = stamp;
+    }
+    else
+    {
+        g_bus_pending &= ~(1 << priority);
+    }
+    
+    SREG = sreg;
+}
+
+
+// Returns true if class may submit now - refused while higher priority is pending
+bool BusRequest(const uint8_t priority)
+{
+    uint16_t stamp = millis();
+    uint8_t sreg = SREG;
+    cli();
+    
+    // Release stale flags of higher priority classes
+    for (uint8_t higher = 0; higher < priority; higher++)
+    {
+        if ((g_bus_pending & (1 << higher)) && ((uint16_t)(stamp - g_bus_stamp[higher]) >= BUS_PENDING_TIMEOUT))
+        {
+            g_bus_pending &= ~(1 << higher);
+        }
+    }
+    
+    bool grant = !(g_bus_pending & ((1 << priority) - 1));
+    volatile uint16_t& count = g_bus_count[priority][grant ? BUS_COUNTER_QUEUED : BUS_COUNTER_DROPPED];
+    
+    if (count < UINT16_MAX)
+    {
+        count++;
+    }
+    
+    SREG = sreg;
+    return grant;
+}
+
+
+void BusLate(const uint8_t priority)
+{
+    uint8_t sreg = SREG;
+    cli();
+    
+    volatile uint16_t& count = g_bus_count[priority][BUS_COUNTER_LATE];
+    
+    if (count < UINT16_MAX)
+    {
+        count++;
+    }
+    
+    SREG = sreg;
+}
+
+
+uint16_t BusGetCount(const uint8_t priority, const uint8_t counter)
+{
+    uint8_t sreg = SREG;
+    cli();
+    uint16_t count = g_bus_count[priority][counter];
+    SREG = sreg;
+    return count;
+}
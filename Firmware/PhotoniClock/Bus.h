@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 PhotonicFusion LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *
+ * @file        Bus.h
+ * @summary     I2C bus arbitration between audio, RTC and LEDs
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _BUS_H
+#define _BUS_H
+
+#include <stdint.h>
+
+const uint16_t BUS_PENDING_TIMEOUT = 250; // Pending flag held longer than this (ms) is released
+
+// Lower value is higher priority
+enum BUS_PRIORITY : uint8_t
+{
+    BUS_PRIORITY_AUDIO, // Music prefetch - underrun is fatal
+    BUS_PRIORITY_RTC,   // Time keeping - may slip by a loop
+    BUS_PRIORITY_LED,   // Frames - may be delayed
+    BUS_PRIORITY_COUNT,
+};
+
+enum BUS_COUNTER : uint8_t
+{
+    BUS_COUNTER_QUEUED,     // Transactions granted
+    BUS_COUNTER_DROPPED,    // Refused for higher priority work
+    BUS_COUNTER_LATE,       // Deadline missed or started behind busy bus
+    BUS_COUNTER_COUNT,
+};
+
+void BusPending(const uint8_t priority, const bool pending);
+bool BusRequest(const uint8_t priority);
+void BusLate(const uint8_t priority);
+uint16_t BusGetCount(const uint8_t priority, const uint8_t counter);
+
+#endif
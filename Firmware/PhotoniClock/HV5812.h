@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 PhotonicFusion LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        HV5812.h
+ * @summary     HV5812 VFD Driver Shift Routine
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _HV5812_H
+#define _HV5812_H
+
+#include <avr/io.h>
+
+/* === Estimated Cycle Counts (16MHz) ===
+
+ Counted by hand from the instruction sequence intended below, not measured
+ or read back from the compiler output - verify against the disassembly
+ (avr-objdump -d) before relying on them.
+
+ Per bit (fully unrolled, port cached in register):
+   mov   r, port        1   clock low, data low
+   sbrc  pattern, n     1/2
+   ori   r, SDATA       1/0
+   out   PORTB, r       1   clock falling edge, data valid
+   nop                  1   clock low >= 125ns
+   ori   r, CLOCK       1
+   out   PORTB, r       1   clock rising edge, data setup >= 125ns
+                       ---
+                        7   (437ns, 2.3MHz shift clock)
+
+ Shift<14> = 2 (port read) + (14 * 7) = 100 cycles
+ Latch     = 4 * sbi/cbi + 2 * nop    =  10 cycles
+
+ The previous loop based routine was estimated at ~16 cycles per bit (224 cycles)
+=============================*/
+
+template<uint8_t CLOCK_MASK, uint8_t SDATA_MASK, uint8_t BIT>
+struct CHV5812Bit
+{
+    static inline void Shift(const uint8_t port, const uint16_t pattern) __attribute__((always_inline))
+    {
+        CHV5812Bit<CLOCK_MASK, SDATA_MASK, 0>::Clock(port, pattern & (1 << BIT));
+        CHV5812Bit<CLOCK_MASK, SDATA_MASK, BIT - 1>::Shift(port, pattern);
+    }
+};
+
+template<uint8_t CLOCK_MASK, uint8_t SDATA_MASK>
+struct CHV5812Bit<CLOCK_MASK, SDATA_MASK, 0>
+{
+    static inline void Shift(const uint8_t port, const uint16_t pattern) __attribute__((always_inline))
+    {
+        Clock(port, pattern & 0x1);
+    }
+
+    static inline void Clock(const uint8_t port, const bool state) __attribute__((always_inline))
+    {
+        uint8_t data = (state) ? (port | SDATA_MASK) : port;
+        PORTB = data; // clock low, sdata
+        asm volatile("nop");
+        PORTB = data | CLOCK_MASK; // clock high
+    }
+};
+
+template<uint8_t PIN_CLOCK, uint8_t PIN_SDATA, uint8_t PIN_LATCH, uint8_t PIN_BLANK>
+class CHV5812
+{
+    static_assert((PIN_CLOCK >= 8) && (PIN_CLOCK < 14), "Clock must be on PORTB");
+    static_assert((PIN_SDATA >= 8) && (PIN_SDATA < 14), "Serial data must be on PORTB");
+    static_assert((PIN_LATCH >= 8) && (PIN_LATCH < 14), "Latch must be on PORTB");
+    static_assert(PIN_BLANK < 8, "Blank must be on PORTD");
+
+    static const uint8_t CLOCK_MASK = (1 << (PIN_CLOCK - 8));
+    static const uint8_t SDATA_MASK = (1 << (PIN_SDATA - 8));
+    static const uint8_t LATCH_MASK = (1 << (PIN_LATCH - 8));
+    static const uint8_t BLANK_MASK = (1 << PIN_BLANK);
+
+    public:
+
+    // Shift lower BITS of pattern MSB first - latch holds current outputs
+    template<uint8_t BITS>
+    __attribute__((always_inline)) static inline void Shift(const uint16_t pattern)
+    {
+        uint8_t port = PORTB & ~(CLOCK_MASK | SDATA_MASK);
+        CHV5812Bit<CLOCK_MASK, SDATA_MASK, BITS - 1>::Shift(port, pattern);
+    }
+
+    // Transfer shift register to outputs - blank only around latch edge
+    static inline void Latch(void) __attribute__((always_inline))
+    {
+        PORTD |= BLANK_MASK; // blank display
+        PORTB |= LATCH_MASK; // latch
+        asm volatile("nop");
+        asm volatile("nop");
+        PORTB &= ~LATCH_MASK; // latch
+        PORTD &= ~BLANK_MASK; // unblank display
+    }
+};
+
+#endif
@@ -60,7 +60,7 @@ CIS31FL3218::status_t CIS31FL3218::SetLEDPWM(const uint8_t led, const uint8_t va
 {
     if (LEDInRange(led))
     {
-        m_led_pwm[led] = value;
+        m_register.pwm[led] = value;
         return I2CWriteByte(ADDRESS_PWM_00 + led, value);
     }
     
@@ -73,11 +73,11 @@ CIS31FL3218::status_t CIS31FL3218::SetLEDState(const uint8_t led, const State st
     if (LEDInRange(led))
     {
         uint8_t address = ADDRESS_CONTROL_0 + (led / COUNT::GROUP);
-        uint8_t byte = m_led_control[led / COUNT::GROUP];
+        uint8_t byte = m_register.control[led / COUNT::GROUP];
 
         // Modify bit
         byte ^= (-getValue(state) ^ byte) & (0x1 << (led % COUNT::GROUP));
-        m_led_control[led / COUNT::GROUP] = byte;
+        m_register.control[led / COUNT::GROUP] = byte;
 
         return I2CWriteByte(address, byte);
     }
@@ -88,23 +88,62 @@ CIS31FL3218::status_t CIS31FL3218::SetLEDState(const uint8_t led, const State st
 
 CIS31FL3218::status_t CIS31FL3218::SetAllPWM(const uint8_t value)
 {
-    memset8(m_led_pwm, value, sizeof(m_led_pwm));
-    return I2CWrite(ADDRESS_PWM_00, m_led_pwm, COUNT::LED);
+    memset8(m_register.pwm, value, sizeof(m_register.pwm));
+    return I2CWrite(ADDRESS_PWM_00, m_register.pwm, COUNT::LED);
 }
 
 
 CIS31FL3218::status_t CIS31FL3218::SetAllState(const State state)
 {
     uint8_t byte = (state == State::ENABLE) ? 0x3F : 0x00;
-    memset8(m_led_control, byte, sizeof(m_led_control));
-    return I2CWrite(ADDRESS_CONTROL_0, m_led_control, COUNT::BANK);
+    memset8(m_register.control, byte, sizeof(m_register.control));
+    return I2CWrite(ADDRESS_CONTROL_0, m_register.control, COUNT::BANK);
 }
 
 
+// Only changed spans are written - gaps shorter than a new transaction are merged
 CIS31FL3218::status_t CIS31FL3218::SetAllPWM(const uint8_t pwm_array[COUNT::LED])
 {
-    memcpy8(m_led_pwm, pwm_array, sizeof(m_led_pwm));
-    return I2CWrite(ADDRESS_PWM_00, m_led_pwm, COUNT::LED);
+    status_t status = STATUS_OK;
+    uint8_t bytes = 0; // Bus bytes sent
+    uint8_t led = 0;
+    
+    while (led < COUNT::LED)
+    {
+        if (m_shadow_valid && (pwm_array[led] == m_register.pwm[led]))
+        {
+            led++;
+            continue; // Unchanged
+        }
+        
+        uint8_t begin = led;
+        uint8_t end = ++led;
+        
+        // Extend span until gap exceeds transaction overhead
+        while ((led < COUNT::LED) && ((led - end) < I2C_OVERHEAD))
+        {
+            if (!m_shadow_valid || (pwm_array[led] != m_register.pwm[led]))
+            {
+                end = led + 1;
+            }
+            
+            led++;
+        }
+        
+        memcpy8(m_register.pwm + begin, pwm_array + begin, end - begin);
+        bytes += (I2C_OVERHEAD + (end - begin));
+        
+        status_t result = I2CWrite(ADDRESS_PWM_00 + begin, m_register.pwm + begin, end - begin);
+        
+        if (result != STATUS_OK)
+        {
+            status = result;
+        }
+    }
+    
+    m_bytes_saved += ((I2C_OVERHEAD + COUNT::LED) - bytes);
+    m_shadow_valid = (status == STATUS_OK);
+    return status;
 }
 
 
@@ -112,14 +151,14 @@ CIS31FL3218::status_t CIS31FL3218::SetAllState(const State state_array[COUNT::LE
 {
     for (uint8_t led = 0; led < COUNT::LED; led++)
     {
-        uint8_t byte = m_led_control[led / COUNT::GROUP];
+        uint8_t byte = m_register.control[led / COUNT::GROUP];
 
         // Modify bit
         byte ^= (-getValue(state_array[led]) ^ byte) & (0x1 << (led % COUNT::GROUP));
-        m_led_control[led / COUNT::GROUP] = byte;
+        m_register.control[led / COUNT::GROUP] = byte;
     }
     
-    return I2CWrite(ADDRESS_CONTROL_0, m_led_control, COUNT::BANK); 
+    return I2CWrite(ADDRESS_CONTROL_0, m_register.control, COUNT::BANK); 
 }
 
 
@@ -127,11 +166,11 @@ CIS31FL3218::status_t CIS31FL3218::SetRGBPWM(const uint8_t rgb, const uint8_t pw
 {
     if (rgb < COUNT::RGB)
     {
-        m_led_pwm[(rgb * 3) + 0] = pwm_array[0];
-        m_led_pwm[(rgb * 3) + 1] = pwm_array[1];
-        m_led_pwm[(rgb * 3) + 2] = pwm_array[2];
+        m_register.pwm[(rgb * 3) + 0] = pwm_array[0];
+        m_register.pwm[(rgb * 3) + 1] = pwm_array[1];
+        m_register.pwm[(rgb * 3) + 2] = pwm_array[2];
         
-        return I2CWrite(ADDRESS_PWM_00 + (rgb * 3), m_led_pwm + (rgb * 3), 3);
+        return I2CWrite(ADDRESS_PWM_00 + (rgb * 3), m_register.pwm + (rgb * 3), 3);
     }
     
     return STATUS_OUT_OF_BOUNDS;
@@ -150,16 +189,88 @@ CIS31FL3218::status_t CIS31FL3218::SetRGBPWM(const uint8_t rgb, const uint32_t c
 }
 
 
+// Latch is skipped if no registers have been written
 CIS31FL3218::status_t CIS31FL3218::Update(void)
 {
-    return I2CWriteByte(ADDRESS_UPDATE, 0x55);
+    if (!m_update_pending)
+    {
+        m_bytes_saved += (I2C_OVERHEAD + 1);
+        return STATUS_OK;
+    }
+    
+    status_t status = I2CWriteByte(ADDRESS_UPDATE, 0x55);
+    m_update_pending = (status != STATUS_OK);
+    return status;
+}
+
+
+// Write frame as one auto-increment burst from first changed register through update
+CIS31FL3218::status_t CIS31FL3218::Commit(const uint8_t pwm_array[COUNT::LED], const State state_array[COUNT::LED])
+{
+    static_assert(sizeof(RegisterStruct) == (ADDRESS_UPDATE - ADDRESS_PWM_00 + 1), "Registers must be contiguous");
+    
+    const uint8_t NONE = sizeof(RegisterStruct);
+    uint8_t* shadow = reinterpret_cast<uint8_t*>(&m_register);
+    uint8_t first = NONE;
+    
+    for (uint8_t led = 0; led < COUNT::LED; led++)
+    {
+        if ((first == NONE) && (!m_shadow_valid || (pwm_array[led] != m_register.pwm[led])))
+        {
+            first = led;
+        }
+        
+        m_register.pwm[led] = pwm_array[led];
+    }
+    
+    if (state_array != nullptr)
+    {
+        for (uint8_t bank = 0; bank < COUNT::BANK; bank++)
+        {
+            uint8_t byte = 0;
+            
+            for (uint8_t led = 0; led < COUNT::GROUP; led++)
+            {
+                byte |= (getValue(state_array[(bank * COUNT::GROUP) + led]) << led);
+            }
+            
+            if ((first == NONE) && (byte != m_register.control[bank]))
+            {
+                first = (uint8_t)(m_register.control - shadow) + bank;
+            }
+            
+            m_register.control[bank] = byte;
+        }
+    }
+    
+    if (first == NONE)
+    {
+        if (!m_update_pending)
+        {
+            m_bytes_saved += (I2C_OVERHEAD + sizeof(RegisterStruct));
+            return STATUS_OK; // Nothing to send
+        }
+        
+        first = (uint8_t)(&m_register.update - shadow); // Latch only
+    }
+    
+    uint8_t bytes = (sizeof(RegisterStruct) - first);
+    m_register.update = 0x55;
+    m_bytes_saved += (first);
+    
+    status_t status = I2CWrite(ADDRESS_PWM_00 + first, shadow + first, bytes);
+    m_shadow_valid = (status == STATUS_OK);
+    m_update_pending = !m_shadow_valid;
+    return status;
 }
 
 
 CIS31FL3218::status_t CIS31FL3218::ResetDevice(void)
 {
     reset();
-    return I2CWriteByte(ADDRESS_RESET, 0x55);
+    status_t status = I2CWriteByte(ADDRESS_RESET, 0x55);
+    m_shadow_valid = (status == STATUS_OK); // Device reset clears registers
+    return status;
 }
 
 
@@ -173,7 +284,7 @@ uint8_t CIS31FL3218::GetLEDPWM(const uint8_t led)
 {
     if (LEDInRange(led))
     {
-        return m_led_pwm[led];
+        return m_register.pwm[led];
     }
     
     return STATUS_OUT_OF_BOUNDS;
@@ -184,7 +295,7 @@ CIS31FL3218::State CIS31FL3218::GetLEDState(const uint8_t led)
 {
     if (LEDInRange(led))
     {
-        uint8_t byte = m_led_control[led / COUNT::GROUP];
+        uint8_t byte = m_register.control[led / COUNT::GROUP];
         bool state = (byte & (0x1 << (led % COUNT::GROUP)));
         return (state ? State::ENABLE : State::DISABLE);
     }
@@ -195,7 +306,7 @@ CIS31FL3218::State CIS31FL3218::GetLEDState(const uint8_t led)
 
 void CIS31FL3218::GetAllPWM(uint8_t pwm_array[COUNT::LED])
 {
-    memcpy8(pwm_array, m_led_pwm, COUNT::LED);
+    memcpy8(pwm_array, m_register.pwm, COUNT::LED);
 }
 
 
@@ -203,7 +314,7 @@ void CIS31FL3218::GetAllState(State state_array[COUNT::LED])
 {
     for (uint8_t led = 0; led < COUNT::LED; led++)
     {
-        State state = (m_led_control[led / COUNT::GROUP] & \
+        State state = (m_register.control[led / COUNT::GROUP] & \
                       (0x1 << (led % COUNT::GROUP))) ? State::ENABLE : State::DISABLE;
         state_array[led] = state;
     }
@@ -214,7 +325,7 @@ void CIS31FL3218::GetRGBPWM(const uint8_t rgb, uint8_t pwm_array[3])
 {
     if (rgb < COUNT::RGB)
     {
-        memcpy8(pwm_array, m_led_pwm + (rgb * 3), 3);
+        memcpy8(pwm_array, m_register.pwm + (rgb * 3), 3);
     }
 }
 
@@ -227,6 +338,12 @@ uint32_t CIS31FL3218::GetRGBPWM(const uint8_t rgb)
 }
 
 
+uint32_t CIS31FL3218::GetBytesSaved(void)
+{
+    return m_bytes_saved;
+}
+
+
 // Declared with weak attribute - will not override FastLED memset8 if present
 void* memset8(void* ptr, const uint8_t value, const uint16_t num)
 {
@@ -243,15 +360,32 @@ void* memcpy8(void* dst, const void* src, const uint16_t num)
 
 void CIS31FL3218::reset(void)
 {
-    memset8(m_led_pwm, 0, sizeof(m_led_pwm));
-    memset8(m_led_control, 0, sizeof(m_led_control));
+    memset8(m_register.pwm, 0, sizeof(m_register.pwm));
+    memset8(m_register.control, 0, sizeof(m_register.control));
+    m_register.update = 0;
     m_device_state = State::DISABLE;
+    m_shadow_valid = false; // Device contents unknown until reset is written
+    m_update_pending = false;
+    m_bytes_saved = 0;
 }
 
 
 CIS31FL3218::status_t CIS31FL3218::I2CWrite(const uint8_t address, const uint8_t data[], const uint8_t bytes)
 {
-    return (status_t)nI2C->Write(m_i2c_handle, address, data, bytes);
+    status_t status = (status_t)nI2C->Write(m_i2c_handle, address, data, bytes);
+    
+    // PWM and control registers take effect on update
+    if ((address >= ADDRESS_PWM_00) && (address <= ADDRESS_CONTROL_2))
+    {
+        m_update_pending = true;
+        
+        if (status != STATUS_OK)
+        {
+            m_shadow_valid = false; // Force full rewrite
+        }
+    }
+    
+    return status;
 }
 
 
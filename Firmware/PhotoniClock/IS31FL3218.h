@@ -61,11 +61,22 @@ class CIS31FL3218
     private:
 
     static const uint8_t I2C_ADDRESS = (0xA8 >> 1);
+    static const uint8_t I2C_OVERHEAD = 2; // Device and register address bytes
     CI2C::Handle m_i2c_handle;
     
+    // Shadow of contiguous registers 0x01 - 0x16 for auto-increment bursts
+    struct RegisterStruct
+    {
+        uint8_t pwm[COUNT::LED];
+        uint8_t control[COUNT::BANK];
+        uint8_t update;
+    };
+    
     State m_device_state;
-    uint8_t m_led_pwm[COUNT::LED];
-    uint8_t m_led_control[COUNT::BANK];
+    RegisterStruct m_register;
+    bool m_shadow_valid; // Shadow registers match device
+    bool m_update_pending; // Registers written since last update
+    uint32_t m_bytes_saved; // Bus bytes avoided by diffing
     
     enum address_t : uint8_t
     {
@@ -110,6 +121,7 @@ class CIS31FL3218
     status_t SetRGBPWM(const uint8_t rgb, const uint8_t pwm_array[3]);
     status_t SetRGBPWM(const uint8_t rgb, const uint32_t color);
     status_t Update(void);
+    status_t Commit(const uint8_t pwm_array[COUNT::LED], const State state_array[COUNT::LED] = nullptr);
     status_t ResetDevice(void);
 
     State GetDeviceState(void);
@@ -119,6 +131,7 @@ class CIS31FL3218
     void GetAllState(State state_array[COUNT::LED]);
     void GetRGBPWM(const uint8_t rgb, uint8_t pwm_array[3]);
     uint32_t GetRGBPWM(const uint8_t rgb);
+    uint32_t GetBytesSaved(void);
 
     private:
     
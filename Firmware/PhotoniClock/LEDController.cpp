@@ -26,11 +26,18 @@
  */
 
 #include "LEDController.h"
+#include "Spectrum.h"
 #include <FastLED.h>
 
 CLED::CLED(const uint8_t r_scale, const uint8_t g_scale, const uint8_t b_scale)
     : m_leds{nullptr}
+    , m_scale{0, 0, 0}
 {
+    for (uint8_t channel = 0; channel < 3; channel++)
+    {
+        BuildTable(channel); // Tables must be valid if scale is unchanged
+    }
+    
     SetScale(r_scale, g_scale, b_scale);
 }
 
@@ -48,36 +55,49 @@ void CLED::AssignLEDs(uint8_t leds[COUNT::LED])
 
 uint8_t CLED::Update(void)
 {
-#ifdef REVISION_A
-    static const uint8_t swap[COUNT::LED] = {0, 1, 2, 9, 10, 11, 3, 4, 5, 12, 13, 14, 6, 7, 8, 15, 16, 17};
-    uint8_t reorder[COUNT::LED];
-#endif
     uint8_t scaled_leds[COUNT::LED];
+    uint8_t lit = 0; // Non-zero if any output is on
     
     if (m_leds != nullptr)
     {
-        // Create local copy
-        memcpy8(scaled_leds, m_leds, sizeof(scaled_leds));
-
-        for (uint8_t led = 0; led < COUNT::LED; led++)
+        for (uint8_t pixel = 0; pixel < COUNT::RGB; pixel++)
         {
-            nscale8_LEAVING_R1_DIRTY(scaled_leds[led], m_scale[led % 3]);
+            const uint8_t* source = &m_leds[3 * pixel];
+            uint8_t* target = &scaled_leds[3 * Layout::Pixel(pixel)]; // Physical mapping
+            
+            for (uint8_t channel = 0; channel < 3; channel++)
+            {
+                uint8_t value = source[channel];
+                const uint8_t* knot = &m_table[channel][value >> TABLE_SHIFT];
+                uint8_t fraction = (value & ((1 << TABLE_SHIFT) - 1));
+                
+                // Interpolate between knots - round up to keep dim channels lit
+                uint8_t delta = knot[1] - knot[0];
+                target[channel] = knot[0] + (((delta * fraction) + ((1 << TABLE_SHIFT) - 1)) >> TABLE_SHIFT);
+                lit |= target[channel];
+            }
         }
-
-        cleanup_R1();
-
-#ifdef REVISION_A
-        // Reorder LEDs according to physical mapping
-        for (uint8_t index = 0; index < COUNT::LED; index++)
+        
+        // Dark frame - shut down driver and stop bus traffic until lit again
+        if (!lit)
         {
-            reorder[swap[index]] = scaled_leds[index];
+            if (m_driver.GetDeviceState() == CIS31FL3218::State::ENABLE)
+            {
+                return m_driver.SetDeviceState(CIS31FL3218::State::DISABLE);
+            }
+            
+            return CIS31FL3218::STATUS_OK;
         }
-
-        m_driver.SetAllPWM(reorder);
-#else
-        m_driver.SetAllPWM(scaled_leds);
-#endif
-        return m_driver.Update();
+        
+        uint8_t status = m_driver.Commit(scaled_leds);
+        
+        // Wake after commit so the first lit frame is already latched
+        if (m_driver.GetDeviceState() == CIS31FL3218::State::DISABLE)
+        {
+            status |= m_driver.SetDeviceState(CIS31FL3218::State::ENABLE);
+        }
+        
+        return status;
     }
     
     return -1; // Error
@@ -98,7 +118,7 @@ void CLED::SetColor(const CRGB color)
 void CLED::SetColor(const CHSV hsv)
 {
     CRGB rgb;
-    hsv2rgb_spectrum(hsv, rgb); // Convert Hue to RGB
+    HueToRGB(hsv, rgb);
     SetColor(rgb);
 }
 
@@ -117,14 +137,60 @@ void CLED::SetColor(const CRGB color, const uint8_t pixel)
 void CLED::SetColor(const CHSV hsv, const uint8_t pixel)
 {
     CRGB rgb;
-    hsv2rgb_spectrum(hsv, rgb); // Convert Hue to RGB
+    HueToRGB(hsv, rgb);
     SetColor(rgb, pixel);
 }
 
 
+// Equivalent to hsv2rgb_spectrum (C path) - table lookup when fully saturated
+void CLED::HueToRGB(const CHSV hsv, CRGB& rgb)
+{
+    if (hsv.saturation == 255)
+    {
+        const uint8_t* ramp = SPECTRUM[hsv.hue];
+        
+        for (uint8_t channel = 0; channel < 3; channel++)
+        {
+            rgb[channel] = ((pgm_read_byte(&ramp[channel]) * hsv.value) >> 8);
+        }
+    }
+    else
+    {
+        hsv2rgb_spectrum(hsv, rgb);
+    }
+}
+
+
+// Tables are only rebuilt when scale changes
 void CLED::SetScale(const uint8_t r_scale, const uint8_t g_scale, const uint8_t b_scale)
 {
-    m_scale[0] = r_scale;
-    m_scale[1] = g_scale;
-    m_scale[2] = b_scale;
+    const uint8_t scale[3] = {r_scale, g_scale, b_scale};
+    
+    for (uint8_t channel = 0; channel < 3; channel++)
+    {
+        if (m_scale[channel] != scale[channel])
+        {
+            m_scale[channel] = scale[channel];
+            BuildTable(channel);
+        }
+    }
+}
+
+
+// Gamma 2.0 followed by scale - non-zero input stays lit if scale is non-zero
+void CLED::BuildTable(const uint8_t channel)
+{
+    for (uint8_t knot = 0; knot < TABLE_SIZE; knot++)
+    {
+        uint16_t value = min(knot << TABLE_SHIFT, 255);
+        uint8_t gamma = ((value * (value + 1)) >> 8);
+        uint8_t output = ((gamma * (m_scale[channel] + 1)) >> 8);
+        
+        if ((output == 0) && value && m_scale[channel])
+        {
+            output = 1;
+        }
+        
+        m_table[channel][knot] = output;
+    }
 }
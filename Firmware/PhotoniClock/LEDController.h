@@ -32,6 +32,26 @@
 #define FASTLED_INTERNAL
 #include <FastLED.h>
 
+// Physical order of RGB pixels on driver outputs
+template<bool INTERLEAVED>
+struct CLEDLayout
+{
+    constexpr static inline uint8_t Pixel(const uint8_t pixel)
+    {
+        return pixel;
+    }
+};
+
+// Revision A routes pixels 0-5 to outputs 0, 3, 1, 4, 2, 5
+template<>
+struct CLEDLayout<true>
+{
+    constexpr static inline uint8_t Pixel(const uint8_t pixel)
+    {
+        return ((pixel >> 1) + ((pixel & 0x1) ? 3 : 0));
+    }
+};
+
 class CLED
 {
     public:
@@ -52,13 +72,27 @@ class CLED
     void SetColor(const CRGB color, const uint8_t pixel);
     void SetColor(const CHSV hsv, const uint8_t pixel);
     void SetScale(const uint8_t r_scale, const uint8_t g_scale, const uint8_t b_scale);
+    static void HueToRGB(const CHSV hsv, CRGB& rgb);
     
     private:
     
+#ifdef REVISION_A
+    typedef CLEDLayout<true> Layout;
+#else
+    typedef CLEDLayout<false> Layout;
+#endif
+    
     CIS31FL3218 m_driver; // LED Driver
     
+    void BuildTable(const uint8_t channel);
+    
+    // Piecewise linear output curve - knots every 8 input steps
+    static const uint8_t TABLE_SHIFT = 3;
+    static const uint8_t TABLE_SIZE = ((256 >> TABLE_SHIFT) + 1);
+    
     uint8_t* m_leds; // LED array
     uint8_t m_scale[3]; // Scaling values
+    uint8_t m_table[3][TABLE_SIZE]; // Gamma, calibration and brightness per channel
 };
 
 #endif
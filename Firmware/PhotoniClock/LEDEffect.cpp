@@ -26,260 +26,528 @@
  */
 
 #include "LEDEffect.h"
+#include "Bus.h"
+#include "Particle.h"
+#include "Profile.h"
  
+extern volatile uint8_t g_led_tick;
 extern StateStruct g_state;
 extern Config g_config;
 extern CLED g_led_controller;
 extern uint8_t g_leds[CLED::COUNT::LED];
 extern CRTC::RTC* g_rtc_struct;
 
+//---------------------------------------------------------------------
+// Effect State
+//---------------------------------------------------------------------
 
-struct CArray
+// All state must be valid when zeroed
+
+struct PulseState
 {
-    union
-    {
-        uint16_t array16[CLED::COUNT::RGB / 2];
-        uint8_t array8[CLED::COUNT::RGB] = {0};
-    };
+    uint8_t value;
+    bool    falling;
+};
+
+struct FireState
+{
+    uint8_t heat[CLED::COUNT::RGB];
+};
+
+struct PongState
+{
+    ParticlePool pool; // Ball
+};
+
+struct FadeState
+{
+    uint8_t     state;
+    uint8_t     hue;
+    uint8_t     count;
+    int8_t      step[3];
+    uint16_t    color[3]; // Pseudo float (x100)
+};
+
+struct RainbowState
+{
+    uint8_t hue;
+};
+
+struct GhostState
+{
+    ParticlePool pool; // Orb
+};
 
-    // Array access operator to index into the CArray object
-	inline uint8_t& operator[] (uint8_t x) __attribute__((always_inline))
+struct DropsState
+{
+    ParticlePool pool; // Drops
+    uint8_t previous_second;
+};
+
+struct VisualState
+{
+    ParticlePool pool; // Notes
+};
+
+struct TetrisState
+{
+    uint8_t state;
+    uint8_t delay;
+    uint8_t hue[CLED::COUNT::RGB];
+};
+
+// Effects which may be selected by Cycle
+union LEDEffectChildState
+{
+    PulseState      pulse;
+    FireState       fire;
+    PongState       pong;
+    FadeState       fade;
+    RainbowState    rainbow;
+    GhostState      ghost;
+    DropsState      drops;
+    TetrisState     tetris;
+};
+
+// Outgoing and incoming effects each keep their own state and frame
+struct CycleState
+{
+    static const uint8_t FADE_STEPS = (LED_CYCLE_FADE / LED_EFFECT_STEP);
+    
+    uint8_t previous_minute;
+    uint8_t effect;
+    uint8_t current; // Index of incoming child
+    uint8_t fade; // Steps remaining in crossfade
+    bool    running; // No crossfade on entry
+    uint8_t leds[2][CLED::COUNT::LED];
+    LEDEffectChildState child[2];
+};
+
+static_assert(CycleState::FADE_STEPS <= UINT8_MAX, "Crossfade window too long");
+
+// Arena size is that of the largest effect
+union LEDEffectState
+{
+    LEDEffectChildState child;
+    CycleState          cycle;
+    VisualState         visual;
+};
+
+//---------------------------------------------------------------------
+// Effect Registry
+//---------------------------------------------------------------------
+
+static void LEDEffectStatic(void* state);
+static void LEDEffectPulse(void* state);
+static void LEDEffectFire(void* state);
+static void LEDEffect1982(void* state);
+static void LEDEffectPong(void* state);
+static void LEDEffectFade(void* state);
+static void LEDEffectRainbow(void* state);
+static void LEDEffectRainbowShift(void* state);
+static void LEDEffectGhost(void* state);
+static void LEDEffectDigitDrops(void* state);
+static void LEDEffectDigit(void* state);
+static void LEDEffectTetris(void* state);
+static void LEDEffectVisualizer(void* state);
+static void LEDEffectCycle(void* state);
+static void LEDEffectDisable(void* state);
+
+// Palette generator - derived from hue setting only
+typedef void (*LEDPaletteBuild)(CRGBPalette16& palette, const uint8_t hue);
+
+static void LEDPaletteFire(CRGBPalette16& palette, const uint8_t hue);
+
+static const char LEDEffect_item_STATIC[] PROGMEM   = "Static";
+static const char LEDEffect_item_PULSE[] PROGMEM    = "Pulse ";
+static const char LEDEffect_item_FIRE[] PROGMEM     = " Fire ";
+static const char LEDEffect_item_1982[] PROGMEM     = " 1982 ";
+static const char LEDEffect_item_PONG[] PROGMEM     = " Pong ";
+static const char LEDEffect_item_FADE[] PROGMEM     = " Fade ";
+static const char LEDEffect_item_RAINBOW[] PROGMEM  = "Rainbo";
+static const char LEDEffect_item_CSHIFT[] PROGMEM   = "CShift";
+static const char LEDEffect_item_GHOST[] PROGMEM    = "Ghost ";
+static const char LEDEffect_item_DROPS[] PROGMEM    = "Drops ";
+static const char LEDEffect_item_DIGIT[] PROGMEM    = "Digit ";
+static const char LEDEffect_item_TETRIS[] PROGMEM   = "Tetris";
+static const char LEDEffect_item_VISUAL[] PROGMEM   = "Visual";
+static const char LEDEffect_item_CYCLE[] PROGMEM    = "Cycle ";
+static const char LEDEffect_item_DISABLE[] PROGMEM  = "Dsable";
+
+// Animation speed is independent of frame period
+// New effects take the next unused id so saved settings keep their meaning
+static const LEDEffectStruct LEDEffect_array[LED_EFFECT_COUNT] PROGMEM =
+{
+    [LED_EFFECT_STATIC]  = {LEDEffectStatic,       100, true,  0,                      0,  LEDEffect_item_STATIC},
+    [LED_EFFECT_PULSE]   = {LEDEffectPulse,        16,  true,  sizeof(PulseState),     1,  LEDEffect_item_PULSE},
+    [LED_EFFECT_FIRE]    = {LEDEffectFire,         16,  true,  sizeof(FireState),      2,  LEDEffect_item_FIRE},
+    [LED_EFFECT_1982]    = {LEDEffect1982,         16,  true,  sizeof(PongState),      3,  LEDEffect_item_1982},
+    [LED_EFFECT_PONG]    = {LEDEffectPong,         16,  false, sizeof(PongState),      4,  LEDEffect_item_PONG},
+    [LED_EFFECT_FADE]    = {LEDEffectFade,         16,  false, sizeof(FadeState),      5,  LEDEffect_item_FADE},
+    [LED_EFFECT_RAINBOW] = {LEDEffectRainbow,      16,  false, sizeof(RainbowState),   6,  LEDEffect_item_RAINBOW},
+    [LED_EFFECT_CSHIFT]  = {LEDEffectRainbowShift, 16,  false, sizeof(RainbowState),   7,  LEDEffect_item_CSHIFT},
+    [LED_EFFECT_GHOST]   = {LEDEffectGhost,        16,  false, sizeof(GhostState),     8,  LEDEffect_item_GHOST},
+    [LED_EFFECT_DROPS]   = {LEDEffectDigitDrops,   16,  false, sizeof(DropsState),     9,  LEDEffect_item_DROPS},
+    [LED_EFFECT_DIGIT]   = {LEDEffectDigit,        16,  false, 0,                      10, LEDEffect_item_DIGIT},
+    [LED_EFFECT_TETRIS]  = {LEDEffectTetris,       16,  false, sizeof(TetrisState),    11, LEDEffect_item_TETRIS},
+    [LED_EFFECT_VISUAL]  = {LEDEffectVisualizer,   16,  true,  sizeof(VisualState),    14, LEDEffect_item_VISUAL},
+    [LED_EFFECT_CYCLE]   = {LEDEffectCycle,        16,  false, sizeof(CycleState),     12, LEDEffect_item_CYCLE},
+    [LED_EFFECT_DISABLE] = {LEDEffectDisable,      100, false, 0,                      13, LEDEffect_item_DISABLE},
+};
+
+// Static globals to reduce SRAM usage
+static LEDEffectState g_effect_state;
+static uint8_t g_effect = LED_EFFECT_COUNT; // Effect owning state arena
+static uint16_t g_frame_count = 0;
+static uint16_t g_skip_count = 0;
+static uint8_t g_frame_scale = 1; // Frame period multiplier
+static CRGBPalette16 g_palette; // Shared by palette effects
+
+//---------------------------------------------------------------------
+// Functions
+//---------------------------------------------------------------------
+
+// Invalid selection falls back to first entry
+static inline const LEDEffectStruct* LEDEffectGet(const uint8_t effect) __attribute__((always_inline));
+static inline const LEDEffectStruct* LEDEffectGet(const uint8_t effect)
+{
+    return &LEDEffect_array[(effect < LED_EFFECT_COUNT) ? effect : LED_EFFECT_STATIC];
+}
+
+
+// Render frame once period of current effect has elapsed
+// Called from main context - main loop, yield() and input callbacks
+void LEDSchedule(void)
+{
+    static bool deferred = false;
+    static uint8_t on_time = 0;
+    uint8_t elapsed = g_led_tick;
+    uint8_t period = min(LEDEffectGetPeriod(g_config.led_effect) * g_frame_scale, UINT8_MAX);
+    
+    if ((g_state.leds == State::DISABLE) || (elapsed < period))
     {
-        return array8[x];
+        return;
     }
-
-    // Array access operator to index into the CArray object
-    inline const uint8_t& operator[] (uint8_t x) const __attribute__((always_inline))
+    
+    // Wait for bus - frame is delayed rather than dropped
+    if (nI2C->IsCommActive())
     {
-        return array8[x];
+        deferred = true;
+        BusLate(BUS_PRIORITY_LED);
+        return;
     }
-};
+    
+    // Yield to imminent audio read or deferred RTC refresh - elapsed time carries to next frame
+    if (!BusRequest(BUS_PRIORITY_LED))
+    {
+        deferred = true;
+        return;
+    }
+    
+    // Lower frame rate while bus is congested - restore once clear
+    if (deferred)
+    {
+        deferred = false;
+        on_time = 0;
+        
+        if (g_frame_scale < LED_FRAME_SCALE_MAX)
+        {
+            g_frame_scale++;
+        }
+    }
+    else if ((++on_time >= 32) && (g_frame_scale > 1))
+    {
+        on_time = 0;
+        g_frame_scale--;
+    }
+    
+    cli();
+    g_led_tick -= elapsed; // Effect time base consumes all elapsed time
+    sei();
+    
+    g_frame_count++;
+    g_skip_count += ((elapsed / period) - 1);
+    
+    // Catch up at most one step beyond the period - time lost while
+    // blocked is dropped rather than rendered step by step
+    uint8_t budget = min(period + LED_EFFECT_STEP, UINT8_MAX);
+    
+    PROFILE_BEGIN(effect);
+    LEDProcess(g_config.led_effect, min(elapsed, budget));
+    g_led_controller.Update(); // Update LEDs
+    PROFILE_END(effect, PROFILE_EFFECT + g_config.led_effect);
+}
 
-// Static globals to reduce SRAM usage
-static int8_t g_addend = 1;
-static uint8_t g_hue = 0;
-static uint8_t g_value = 0;
-static CRGB g_rgb;
-static CArray g_array;
 
-// Called periodically on 1/60Hz intervals
-void LEDProcess(const uint8_t effect)
+uint16_t LEDGetFrameCount(void)
+{
+    return g_frame_count;
+}
+
+
+uint16_t LEDGetSkipCount(void)
+{
+    return g_skip_count;
+}
+
+
+// Advance effect by elapsed time - effects step every LED_EFFECT_STEP ms
+// Frame rate may vary without changing animation speed (LEDSchedule caps lag)
+void LEDProcess(const uint8_t effect, const uint8_t elapsed)
 {
+    static uint16_t step_time = 0;
+    const LEDEffectStruct* descriptor = LEDEffectGet(effect);
+    
     // If in menu, fake changes to RTC
     if (g_state.menu == State::ENABLE)
     {
-        static uint8_t cycle = 0;
+        static uint16_t menu_time = 0;
         
         // Update every second
-        if (cycle++ > 59)
+        if ((menu_time += elapsed) >= 1000)
         {
             g_rtc_struct->second++;
-            cycle = 0;
+            menu_time -= 1000;
         }
     }
     
-    switch (effect)
+    // Effect starts from zeroed state and step phase
+    if (effect != g_effect)
     {
-    default:
-    case LED_EFFECT_STATIC:
-        LEDEffectStatic();
-        break;
-    case LED_EFFECT_PULSE:
-        LEDEffectPulse();
-        break;
-    case LED_EFFECT_FIRE:
-        LEDEffectFire();
-        break;
-    case LED_EFFECT_1982:
-        LEDEffectPong(true);
-        break;
-    case LED_EFFECT_PONG:
-        LEDEffectPong(false);
-        break;
-    case LED_EFFECT_FADE:
-        LEDEffectFade();
-        break;
-    case LED_EFFECT_RAINBOW:
-        LEDEffectRainbow();
-        break;
-    case LED_EFFECT_CSHIFT:
-        LEDEffectRainbowShift();
-        break;
-    case LED_EFFECT_GHOST:
-        LEDEffectGhost();
-        break;
-    case LED_EFFECT_DROPS:
-        LEDEffectDigitDrops();
-        break;
-    case LED_EFFECT_DIGIT:
-        LEDEffectDigit();
-        break;
-    case LED_EFFECT_TETRIS:
-        LEDEffectTetris();
-        break;
-    case LED_EFFECT_CYCLE:
-        LEDEffectCycle();
-        break;
-    case LED_EFFECT_DISABLE:
-        LEDEffectDisable();
-        break;
+        g_effect = effect;
+        step_time = 0;
+        memset(&g_effect_state, 0, pgm_read_byte(&descriptor->size));
+        memset8(g_leds, 0, CLED::COUNT::LED);
+    }
+    
+    LEDEffectRender render = reinterpret_cast<LEDEffectRender>(pgm_read_ptr(&descriptor->render));
+    
+    for (step_time += elapsed; step_time >= LED_EFFECT_STEP; step_time -= LED_EFFECT_STEP)
+    {
+        render(&g_effect_state);
     }
 }
 
 
-void LEDEffectStatic(void)
+uint8_t LEDEffectGetPeriod(const uint8_t effect)
 {
-    CHSV hsv = {g_config.led_hue, 255, 255};
-    g_led_controller.SetColor(hsv);
+    return pgm_read_byte(&LEDEffectGet(effect)->period);
 }
 
 
-void LEDEffectPulse(void)
+bool LEDEffectIsHue(const uint8_t effect)
 {
-    g_value += (uint8_t)g_addend;
-    
-    if (g_value == 0)
+    return pgm_read_byte(&LEDEffectGet(effect)->hue);
+}
+
+
+PGM_P LEDEffectGetName(const uint8_t effect)
+{
+    return reinterpret_cast<PGM_P>(pgm_read_ptr(&LEDEffectGet(effect)->name));
+}
+
+
+uint8_t LEDEffectGetId(const uint8_t effect)
+{
+    return pgm_read_byte(&LEDEffectGet(effect)->id);
+}
+
+
+// Unknown id falls back to first entry
+uint8_t LEDEffectFromId(const uint8_t id)
+{
+    for (uint8_t effect = 0; effect < LED_EFFECT_COUNT; effect++)
     {
-        g_addend = -g_addend;
-        g_value += (uint8_t)g_addend;
+        if (pgm_read_byte(&LEDEffect_array[effect].id) == id)
+        {
+            return effect;
+        }
     }
+    
+    return LED_EFFECT_STATIC;
+}
 
-    CHSV hsv = {g_config.led_hue, 255, g_value};
-    g_led_controller.SetColor(hsv);
+
+// Palette is only rebuilt when generator or hue changes
+static const CRGBPalette16& LEDPaletteGet(const LEDPaletteBuild build, const uint8_t hue)
+{
+    static LEDPaletteBuild cached_build = nullptr;
+    static uint8_t cached_hue = 0;
+    
+    if ((build != cached_build) || (hue != cached_hue))
+    {
+        cached_build = build;
+        cached_hue = hue;
+        build(g_palette, hue);
+    }
+    
+    return g_palette;
 }
 
 
-void LEDEffectFire(void)
-{    
+static void LEDPaletteFire(CRGBPalette16& palette, const uint8_t hue)
+{
     CHSV hsv = {0, 255, 255};
     CRGB low;
     CRGB mid;
     CRGB high;
     
-    hsv.hue = g_config.led_hue + 25;
-    hsv2rgb_spectrum(hsv, mid);
-    hsv.hue = g_config.led_hue + 00;
-    hsv2rgb_spectrum(hsv, low);
+    hsv.hue = hue + 25;
+    CLED::HueToRGB(hsv, mid);
+    hsv.hue = hue + 00;
+    CLED::HueToRGB(hsv, low);
     hsv.saturation = 200;
-    hsv2rgb_spectrum(hsv, high);
+    CLED::HueToRGB(hsv, high);
+    
+    palette = CRGBPalette16(CRGB::Black, low, mid, high);
+}
+
+
+static void LEDEffectStatic(void* state)
+{
+    CHSV hsv = {g_config.led_hue, 255, 255};
+    g_led_controller.SetColor(hsv);
+}
+
+
+static void LEDEffectPulse(void* state)
+{
+    PulseState& pulse = *static_cast<PulseState*>(state);
+    int8_t addend = (pulse.falling ? -1 : 1);
     
-    CRGBPalette16 palette = CRGBPalette16(CRGB::Black, low, mid, high);
+    pulse.value += (uint8_t)addend;
+    
+    if (pulse.value == 0)
+    {
+        pulse.falling = !pulse.falling;
+        pulse.value -= (uint8_t)addend;
+    }
+
+    CHSV hsv = {g_config.led_hue, 255, pulse.value};
+    g_led_controller.SetColor(hsv);
+}
+
+
+static void LEDEffectFire(void* state)
+{
+    FireState& fire = *static_cast<FireState*>(state);
+    const CRGBPalette16& palette = LEDPaletteGet(LEDPaletteFire, g_config.led_hue);
 
     // Step 1.  Cool down every cell a little
     for (uint8_t i = 0; i < CLED::COUNT::RGB; i++)
     {
-        g_array[i] = qsub8(g_array[i], random8(0, (18 / CLED::COUNT::RGB) + 3));
+        fire.heat[i] = qsub8(fire.heat[i], random8(0, (18 / CLED::COUNT::RGB) + 3));
     }
 
     // Step 2.  Heat from each cell drifts 'up' and diffuses a little
     for (uint8_t k = CLED::COUNT::RGB - 1; k >= 2; k--)
     {
-        g_array[k] = (g_array[k - 1] + g_array[k - 2] + g_array[k - 2]) / 3;
+        fire.heat[k] = (fire.heat[k - 1] + fire.heat[k - 2] + fire.heat[k - 2]) / 3;
     }
 
     // Step 3.  Randomly ignite new 'sparks'
     if (random8() < 100)
     {
         uint8_t y = random8(4);
-        g_array[y] = qadd8(g_array[y], random8(15, 25));
+        fire.heat[y] = qadd8(fire.heat[y], random8(15, 25));
     }
 
     // Step 4.  Map from heat cells to LED colors
     for (uint8_t pixel = 0; pixel < CLED::COUNT::RGB; pixel++)
     {
-        CRGB color = ColorFromPalette(palette, g_array[pixel]);
+        CRGB color = ColorFromPalette(palette, fire.heat[pixel]);
         g_led_controller.SetColor(color, pixel);
     }
 }
 
 
-void LEDEffectPong(bool use_led_hue = true)
+static void LEDEffectPong(PongState& pong, const bool use_led_hue)
 {
     const uint8_t VALUE_ADJUST = (use_led_hue ? 12 : 5);
-    static uint8_t position = 0;
-
-    // Delay position update
-    if (g_value++ > ((use_led_hue) ? 3 : 8))
+    const int16_t SPEED = (use_led_hue ? (256 / 5) : (256 / 10)); // Pixels per step
+    const int16_t LIMIT = (2 << 8); // Ball travels "off screen" before returning
+    ParticlePool& pool = pong.pool;
+    
+    if (pool.value[0] == 0)
     {
-        g_value = 0;
-        position += (uint8_t)g_addend;
-        
-        if (use_led_hue)
-        {
-            g_hue = g_config.led_hue;
-        }
-        else
-        {
-            g_hue += 8;
-        }
-        
-        // Position allowed to travel "off screen"
-        if ((position == 0) || (position == (CLED::COUNT::RGB + 3)))
-        {
-            g_addend = -g_addend;
-        }
-        
-        // Position could go out of bounds if the routine enters when position
-        // is at the boundary and g_addend is reverse polarity
-        if (position > (CLED::COUNT::RGB + 3))
-        {
-            // Reset to safe position
-            position = 2;
-        }
-        
-        // Re-illuminate pixels
-        if ((position > 1) && (position < CLED::COUNT::RGB + 2))
-        {
-            g_array[position - 2] = 255;
-        }
+        ParticleSpawn(pool, -LIMIT, SPEED, (255 << 8), 0, g_config.led_hue, 255);
     }
-
-    CHSV hsv = {g_hue, 255, 0};
     
-    // Iterate through all pixels and update value
-    for (uint8_t pixel = 0; pixel < CLED::COUNT::RGB; pixel++)
+    int8_t pixel = (pool.position[0] >> 8);
+    ParticleStep(pool);
+    
+    if (use_led_hue)
     {
-        hsv.value = g_array[pixel];
-        g_led_controller.SetColor(hsv, pixel);
-        g_array[pixel] = qsub8(g_array[pixel], VALUE_ADJUST);
+        pool.hue[0] = g_config.led_hue;
+    }
+    else if (pixel != (pool.position[0] >> 8))
+    {
+        pool.hue[0] += 8; // Shift hue on each new pixel
+    }
+    
+    // Reverse direction at boundary
+    if (((pool.position[0] <= -LIMIT) && (pool.velocity[0] < 0)) ||
+        ((pool.position[0] >= (((CLED::COUNT::RGB - 1) << 8) + LIMIT)) && (pool.velocity[0] > 0)))
+    {
+        pool.velocity[0] = -pool.velocity[0];
+    }
+    
+    // Fade trail
+    for (uint8_t led = 0; led < CLED::COUNT::LED; led++)
+    {
+        g_leds[led] = qsub8(g_leds[led], VALUE_ADJUST);
     }
+    
+    ParticleRender(pool, g_leds);
+}
+
+
+static void LEDEffect1982(void* state)
+{
+    LEDEffectPong(*static_cast<PongState*>(state), true);
 }
 
 
-void LEDEffectFade(void)
+static void LEDEffectPong(void* state)
 {
+    LEDEffectPong(*static_cast<PongState*>(state), false);
+}
+
+
+static void LEDEffectFade(void* state)
+{
+    FadeState& fade = *static_cast<FadeState*>(state);
+    
     enum FADE : uint8_t
     {
         FADE_GENERATE,
         FADE_TRANSITION,
         FADE_WAIT,
     };
-
-    static uint8_t state = FADE_GENERATE;
     
-    switch (state)
+    switch (fade.state)
     {
     default:
     case FADE_GENERATE:
     {
         // Calculate RGB values of current and next hue
-        CHSV current_hsv = {g_hue, 255, 255};
+        CHSV current_hsv = {fade.hue, 255, 255};
         CRGB current_rgb;
-        hsv2rgb_spectrum(current_hsv, current_rgb);
-        g_hue = random8();
-        CHSV next_hsv = {g_hue, 255, 255};
+        CLED::HueToRGB(current_hsv, current_rgb);
+        fade.hue = random8();
+        CHSV next_hsv = {fade.hue, 255, 255};
         CRGB next_rgb;
-        hsv2rgb_spectrum(next_hsv, next_rgb);
+        CLED::HueToRGB(next_hsv, next_rgb);
         
         // Calculate hue offsets in RGB values
         for (uint8_t index = 0; index < 3; index++)
         {
-            g_rgb[index] = ((next_rgb[index] - current_rgb[index]) / 2); // Sign conversion
-            g_array.array16[index] = (100 * current_rgb[index]); // Pseudo float
+            fade.step[index] = ((next_rgb[index] - current_rgb[index]) / 2);
+            fade.color[index] = (100 * current_rgb[index]); // Pseudo float
         }
 
-        g_value = 0;
-        state = FADE_TRANSITION;
+        fade.count = 0;
+        fade.state = FADE_TRANSITION;
         break;
     }
     case FADE_TRANSITION:
@@ -288,138 +556,103 @@ void LEDEffectFade(void)
         
         for (uint8_t index = 0; index < 3; index++)
         {
-            g_array.array16[index] += ((int8_t)g_rgb[index]); // Apply signed offset
-            color[index] = (g_array.array16[index] / 100); // Pseudo float
+            fade.color[index] += fade.step[index]; // Apply signed offset
+            color[index] = (fade.color[index] / 100); // Pseudo float
         }
         
         g_led_controller.SetColor(color);
         
-        if (g_value++ >= 199)
+        if (fade.count++ >= 199)
         {
-            state = FADE_WAIT;
-            g_value = 0;
+            fade.state = FADE_WAIT;
+            fade.count = 0;
         }
         
         break;
     }
     case FADE_WAIT:
-        if (g_value++ >= 199)
+        if (fade.count++ >= 199)
         {
-            state = FADE_GENERATE;
+            fade.state = FADE_GENERATE;
         }
         break;
     }
 }
 
 
-void LEDEffectRainbow(void)
+static void LEDEffectRainbow(void* state)
 {
-    uint8_t value = ++g_hue;
-    CHSV hsv = {value, 255, 255};
+    RainbowState& rainbow = *static_cast<RainbowState*>(state);
+    CHSV hsv = {++rainbow.hue, 255, 255};
     g_led_controller.SetColor(hsv);
 }
 
 
-void LEDEffectRainbowShift(void)
+static void LEDEffectRainbowShift(void* state)
 {
-    g_hue++;
+    RainbowState& rainbow = *static_cast<RainbowState*>(state);
+    rainbow.hue++;
     
     for (uint8_t pixel = 0; pixel < CLED::COUNT::RGB; pixel++)
     {
-        uint8_t value = g_hue + (pixel * 16);
+        uint8_t value = rainbow.hue + (pixel * 16);
         CHSV hsv = {value, 255, 255};
         g_led_controller.SetColor(hsv, pixel);
     }
 }
 
 
-void LEDEffectGhost(void)
+static void LEDEffectGhost(void* state)
 {
-    // Allow "off screen" writes
-    const uint8_t WIDTH = 2; // pixels left/right of orb center
-    const uint8_t OVERSCAN = 1; // non-visible pixels left/right of display
-    static CRGB led[CLED::COUNT::RGB + (OVERSCAN * 2)] = {0};
-    static uint8_t position = 0;
-    static uint8_t color_index = 0;
-
-    if (g_value < 2)
+    static const uint8_t CHANNEL_HUE[3] = {0, 86, 171}; // Red, Green, Blue
+    ParticlePool& pool = static_cast<GhostState*>(state)->pool;
+    const uint16_t value = (7 << 8); // Center gains about ((value >> 8) - 2) per step
+    const uint16_t decay = 20; // Orb lasts (value / decay) steps
+    const uint8_t falloff = 1; // Each pixel from center gains one less
+    
+    // New orb once previous has faded - may be centered off screen
+    // Center peaks near 125 and neighbours near 65, as the original orb
+    if (pool.value[0] == 0)
     {
-        color_index = random8(3);
-        position = WIDTH + random8(CLED::COUNT::RGB + (OVERSCAN * 2) - (WIDTH * 2));
+        int16_t position = ((int16_t)random8(CLED::COUNT::RGB + 2) - 1) << 8;
+        ParticleSpawn(pool, position, 0, value, decay, CHANNEL_HUE[random8(3)], falloff);
     }
     
-    g_value += 2;
+    ParticleStep(pool);
     
-    for (uint8_t offset = 0; offset < ((WIDTH * 2) + 1); offset++) // Add one for center
+    // Orb builds up where it is brighter than the fade
+    for (uint8_t led = 0; led < CLED::COUNT::LED; led++)
     {
-        uint8_t fade = 50 * abs(offset - WIDTH);
-
-        // Create fade effect from center of orb   
-        if (((fade + g_value) < 250) && ((g_value + 10) > fade))
-        {
-            uint8_t value = qadd8(led[position + offset - WIDTH][color_index], 2);
-            led[position + offset - WIDTH][color_index] = value;
-        }
+        g_leds[led] = qsub8(g_leds[led], 1);
     }
     
-    // Iterate through all visible pixels and update value
-    for (uint8_t pixel = 0; pixel < CLED::COUNT::RGB; pixel++)
-    {
-        g_led_controller.SetColor(led[pixel + OVERSCAN], pixel);
-        led[pixel + OVERSCAN]--;
-    }
+    ParticleRender(pool, g_leds);
 }
 
 
-void LEDEffectDigitDrops(void)
+static void LEDEffectDigitDrops(void* state)
 {
-    static uint8_t previous_second = 0;
-    const uint8_t decay = 2; //Higher is faster
-    const uint8_t pull = 5; //Lower is faster
+    static const uint8_t CHANNEL_HUE[3] = {0, 86, 171}; // Red, Green, Blue
+    DropsState& drops = *static_cast<DropsState*>(state);
+    const uint16_t decay = (2 << 8); // Higher is faster
+    const uint8_t falloff = 128; // Lower spreads further
 
-    //Just ticked a second
-    if (previous_second != g_rtc_struct->second)
+    // Just ticked a second
+    if (drops.previous_second != g_rtc_struct->second)
     {
-        previous_second = g_rtc_struct->second;
-        uint8_t digit = 3 * random8(CLED::COUNT::RGB);
-
-        uint8_t offset = (g_rtc_struct->second % 3);
-        g_leds[digit + offset] = 255;
-        g_rgb[offset] = 255;
+        drops.previous_second = g_rtc_struct->second;
+        int16_t position = (random8(CLED::COUNT::RGB) << 8);
+        uint8_t hue = CHANNEL_HUE[g_rtc_struct->second % 3];
+        ParticleSpawn(drops.pool, position, 0, (255 << 8), decay, hue, falloff);
     }
 
-    //Make temporary array
-    uint8_t temp[CLED::COUNT::LED] = {0};
-    
-    //Spread
-    //1 = min(((2 >> pull) + 1), max)
-    for (uint8_t index = 0; index < 3; index++)
-    {
-        temp[index] = min((g_leds[index + 3] >> pull) + g_leds[index], g_rgb[index]);
-    }
-
-    //2 = min(((3 >> pull) + (1 >> pull) + 2), max) (same through 5)
-    for (uint8_t i = 3; i < 15; i += 3)
-    {
-        for (uint8_t j = 0; j < 3; j++)
-        {
-            temp[(i + j)] = min((g_leds[(i + j)+3] >> pull) + (g_leds[(i + j)-3] >> pull) + g_leds[(i + j)], g_rgb[j]);
-        }
-    }
-
-    //6 = min(((5 >> pull) + 1), max)
-    for (uint8_t index = 0; index < 3; index++)
-    {
-        temp[index + 15] = min((g_leds[index + 12] >> pull) + g_leds[index + 15], g_rgb[index]);
-        g_rgb[index] = qsub8(g_rgb[index], decay); // Decay
-    }
-    
-    //Copy data from temp to g_leds
-    memcpy8(g_leds, temp, CLED::COUNT::LED);
+    ParticleStep(drops.pool);
+    memset8(g_leds, 0, CLED::COUNT::LED);
+    ParticleRender(drops.pool, g_leds);
 }
 
 
-void LEDEffectDigit(void)
+static void LEDEffectDigit(void* state)
 {
     CHSV hsv = {0, 255, 255};
     
@@ -444,8 +677,10 @@ void LEDEffectDigit(void)
 }
 
 
-void LEDEffectTetris(void)
+static void LEDEffectTetris(void* state)
 {
+    TetrisState& tetris = *static_cast<TetrisState*>(state);
+    
     enum TETRIS : uint8_t
     {
         TETRIS_GENERATE,
@@ -453,24 +688,23 @@ void LEDEffectTetris(void)
         TETRIS_SHIFT_OUT,
     };
     
-    if (++g_value > 8)
+    if (++tetris.delay > 8)
     {
-        static uint8_t state = TETRIS_GENERATE;
-        g_value = 0;
+        tetris.delay = 0;
         
-        switch (state)
+        switch (tetris.state)
         {
         default:
         case TETRIS_GENERATE:
             // Check if full
-            if (g_array[CLED::COUNT::RGB - 1] > 0)
+            if (tetris.hue[CLED::COUNT::RGB - 1] > 0)
             {
-                state = TETRIS_SHIFT_OUT;
+                tetris.state = TETRIS_SHIFT_OUT;
             }
             else
             {
-                g_array[CLED::COUNT::RGB - 1] = random8(1, 255);
-                state = TETRIS_SHIFT_IN;
+                tetris.hue[CLED::COUNT::RGB - 1] = random8(1, 255);
+                tetris.state = TETRIS_SHIFT_IN;
             }
             break;
         case TETRIS_SHIFT_IN:
@@ -481,20 +715,20 @@ void LEDEffectTetris(void)
             for (uint8_t index = 0; index < CLED::COUNT::RGB - 1; index++)
             {
                 // Check if space exists
-                if (g_array[index] == 0)
+                if (tetris.hue[index] == 0)
                 {
                     // Check if next space occupied
-                    if (g_array[index + 1] > 0)
+                    if (tetris.hue[index + 1] > 0)
                     {
                         shift = true;
-                        g_array[index] = g_array[index + 1]; // Slide
-                        g_array[index + 1] = 0; // Create empty space
+                        tetris.hue[index] = tetris.hue[index + 1]; // Slide
+                        tetris.hue[index + 1] = 0; // Create empty space
                     }
                 }
             }
 
             // Check if all shifts occurred
-            if (shift == false) { state = TETRIS_GENERATE; }
+            if (shift == false) { tetris.state = TETRIS_GENERATE; }
             
             break;
         }
@@ -505,21 +739,21 @@ void LEDEffectTetris(void)
             for (uint8_t index = 0; index < CLED::COUNT::RGB; index++)
             {
                 // Check if space occupied
-                if (g_array[index] > 0)
+                if (tetris.hue[index] > 0)
                 {
                     if (index > 0)
                     {
-                        g_array[index - 1] = g_array[index];
+                        tetris.hue[index - 1] = tetris.hue[index];
                     }
                     
                     shift = true;
-                    g_array[index] = 0;
+                    tetris.hue[index] = 0;
                     break; // End loop
                 }
             }
 
             // Check if all shifts occurred
-            if (shift == false) { state = TETRIS_GENERATE; }
+            if (shift == false) { tetris.state = TETRIS_GENERATE; }
             
             break;
         }
@@ -530,9 +764,9 @@ void LEDEffectTetris(void)
         // Iterate through all pixels and update value
         for (uint8_t pixel = 0; pixel < CLED::COUNT::RGB; pixel++)
         {
-            if (g_array[pixel] > 0)
+            if (tetris.hue[pixel] > 0)
             {
-                hsv.hue = g_array[pixel];
+                hsv.hue = tetris.hue[pixel];
                 hsv.value = 255;
             }
             else
@@ -546,24 +780,95 @@ void LEDEffectTetris(void)
 }
 
 
-void LEDEffectCycle(void)
+// Spawn a particle per note - position by pitch class, fade by duration
+static void LEDEffectVisualizer(void* state)
+{
+    ParticlePool& pool = static_cast<VisualState*>(state)->pool;
+    NoteEvent event;
+    
+    while (NoteEventRead(event))
+    {
+        int16_t position = (((event.pitch % 12) >> 1) << 8); // Two semitones per pixel
+        uint8_t hue = g_config.led_hue + (event.channel ? 128 : 0) + ((event.pitch / 12) << 4);
+        uint8_t length = (event.duration - DURATION::DTS) >> 2; // 0 (short) to 3 (long)
+        ParticleSpawn(pool, position, 0, (255 << 8), ((16 << 8) >> min(length, 3)), hue, 192);
+    }
+    
+    ParticleStep(pool);
+    memset8(g_leds, 0, CLED::COUNT::LED);
+    ParticleRender(pool, g_leds);
+}
+
+
+// Select effect based on cycle count
+// Skip Static, Visualizer and Disabled settings
+static inline LEDEffectRender LEDEffectCycleGet(const uint8_t count)
 {
-    static uint8_t previous_minute = 0;
-    static uint8_t effect = 0;
+    uint8_t effect = 1 + (count % (LED_EFFECT_VISUAL - 1));
+    return reinterpret_cast<LEDEffectRender>(pgm_read_ptr(&LEDEffectGet(effect)->render));
+}
+
+
+static void LEDEffectCycle(void* state)
+{
+    CycleState& cycle = *static_cast<CycleState*>(state);
+    uint8_t incoming = cycle.current;
+    uint8_t outgoing = (incoming ^ 1);
     
-    if (previous_minute != g_rtc_struct->minute)
+    if (cycle.previous_minute != g_rtc_struct->minute)
     {
-        previous_minute = g_rtc_struct->minute;
-        effect++;
+        cycle.previous_minute = g_rtc_struct->minute;
+        cycle.effect++;
+        
+        if (cycle.running)
+        {
+            // Current effect becomes outgoing - keep its frame
+            memcpy8(cycle.leds[incoming], g_leds, CLED::COUNT::LED);
+            outgoing = incoming;
+            incoming = cycle.current = (outgoing ^ 1);
+            memset8(cycle.leds[incoming], 0, CLED::COUNT::LED);
+            cycle.fade = CycleState::FADE_STEPS;
+        }
+        
+        memset(&cycle.child[incoming], 0, sizeof(cycle.child[incoming])); // Next effect starts from zeroed state
     }
     
-    // Select effect based on current minute
-    // Skip Static and Disabled settings
-    LEDProcess(1 + (effect % (LED_EFFECT_CYCLE - 1)));
+    cycle.running = true;
+    
+    if (cycle.fade == 0)
+    {
+        LEDEffectCycleGet(cycle.effect)(&cycle.child[incoming]);
+        return;
+    }
+    
+    // Render each effect against its own frame
+    uint8_t* frame_out = cycle.leds[outgoing];
+    uint8_t* frame_in = cycle.leds[incoming];
+    
+    memcpy8(g_leds, frame_out, CLED::COUNT::LED);
+    LEDEffectCycleGet(cycle.effect - 1)(&cycle.child[outgoing]);
+    memcpy8(frame_out, g_leds, CLED::COUNT::LED);
+    
+    memcpy8(g_leds, frame_in, CLED::COUNT::LED);
+    LEDEffectCycleGet(cycle.effect)(&cycle.child[incoming]);
+    
+    if (--cycle.fade == 0)
+    {
+        return; // Incoming frame left in g_leds
+    }
+    
+    memcpy8(frame_in, g_leds, CLED::COUNT::LED);
+    
+    uint8_t amount = 255 - ((cycle.fade * 255) / CycleState::FADE_STEPS);
+    
+    for (uint8_t led = 0; led < CLED::COUNT::LED; led++)
+    {
+        g_leds[led] = blend8(frame_out[led], frame_in[led], amount);
+    }
 }
 
 
-void LEDEffectDisable(void)
+static void LEDEffectDisable(void* state)
 {
     CHSV hsv = {0, 0, 0};
     g_led_controller.SetColor(hsv);
@@ -31,15 +31,13 @@
 #include "PhotoniClock.h"
 
 // Menu order determined by enum order
+// Each entry requires a descriptor in LEDEffect_array (LEDEffect.cpp)
 enum LED_EFFECT : uint8_t
 {
-    // Effects that use Hue
     LED_EFFECT_STATIC, // Must be first
     LED_EFFECT_PULSE,
     LED_EFFECT_FIRE,
     LED_EFFECT_1982,
-    
-    // Effects that do not use Hue
     LED_EFFECT_PONG,
     LED_EFFECT_FADE,
     LED_EFFECT_RAINBOW,
@@ -48,57 +46,38 @@ enum LED_EFFECT : uint8_t
     LED_EFFECT_DROPS,
     LED_EFFECT_DIGIT,
     LED_EFFECT_TETRIS,
+    LED_EFFECT_VISUAL,
     LED_EFFECT_CYCLE,   // Must be penultimate
     LED_EFFECT_DISABLE, // Must be last
     LED_EFFECT_COUNT,   // Number of entries
 };
 
-static const char LEDEffect_item_STATIC[] PROGMEM   = "Static";
-static const char LEDEffect_item_PULSE[] PROGMEM    = "Pulse ";
-static const char LEDEffect_item_FIRE[] PROGMEM     = " Fire ";
-static const char LEDEffect_item_1982[] PROGMEM     = " 1982 ";
-static const char LEDEffect_item_PONG[] PROGMEM     = " Pong ";
-static const char LEDEffect_item_FADE[] PROGMEM     = " Fade ";
-static const char LEDEffect_item_RAINBOW[] PROGMEM  = "Rainbo";
-static const char LEDEffect_item_CSHIFT[] PROGMEM   = "CShift";
-static const char LEDEffect_item_GHOST[] PROGMEM    = "Ghost ";
-static const char LEDEffect_item_DROPS[] PROGMEM    = "Drops ";
-static const char LEDEffect_item_DIGIT[] PROGMEM    = "Digit ";
-static const char LEDEffect_item_TETRIS[] PROGMEM   = "Tetris";
-static const char LEDEffect_item_CYCLE[] PROGMEM    = "Cycle ";
-static const char LEDEffect_item_DISABLE[] PROGMEM  = "Dsable";
+const uint8_t LED_EFFECT_STEP = 16; // Animation time step (ms)
+const uint8_t LED_FRAME_SCALE_MAX = 4; // Lowest frame rate is 1/4 under bus load
+const uint16_t LED_CYCLE_FADE = 2000; // Cycle crossfade window (ms)
 
-static PGM_P const LEDEffect_item_array[LED_EFFECT_COUNT] PROGMEM =
+// Render function advances one step - receives state from the shared arena
+typedef void (*LEDEffectRender)(void* state);
+
+// Effect descriptor - stored in PROGMEM
+struct LEDEffectStruct
 {
-    [LED_EFFECT_STATIC] = LEDEffect_item_STATIC,
-    [LED_EFFECT_PULSE] = LEDEffect_item_PULSE,
-    [LED_EFFECT_FIRE] = LEDEffect_item_FIRE,
-    [LED_EFFECT_1982] = LEDEffect_item_1982,
-    [LED_EFFECT_PONG] = LEDEffect_item_PONG,
-    [LED_EFFECT_FADE] = LEDEffect_item_FADE,
-    [LED_EFFECT_RAINBOW] = LEDEffect_item_RAINBOW,
-    [LED_EFFECT_CSHIFT] = LEDEffect_item_CSHIFT,
-    [LED_EFFECT_GHOST] = LEDEffect_item_GHOST,
-    [LED_EFFECT_DROPS] = LEDEffect_item_DROPS,
-    [LED_EFFECT_DIGIT] = LEDEffect_item_DIGIT,
-    [LED_EFFECT_TETRIS] = LEDEffect_item_TETRIS,
-    [LED_EFFECT_CYCLE] = LEDEffect_item_CYCLE,
-    [LED_EFFECT_DISABLE] = LEDEffect_item_DISABLE,
+    LEDEffectRender render; // Frame render function
+    uint8_t         period; // Frame period (ms)
+    bool            hue;    // Effect uses led_hue setting
+    uint8_t         size;   // Bytes of state arena used (zeroed on entry)
+    uint8_t         id;     // Value saved in Config - never reused or reordered
+    PGM_P           name;   // Menu item
 };
 
-void LEDProcess(const uint8_t effect);
-void LEDEffectStatic(void);
-void LEDEffectPulse(void);
-void LEDEffectFire(void);
-void LEDEffectPong(bool);
-void LEDEffectFade(void);
-void LEDEffectRainbow(void);
-void LEDEffectRainbowShift(void);
-void LEDEffectGhost(void);
-void LEDEffectDigitDrops(void);
-void LEDEffectDigit(void);
-void LEDEffectTetris(void);
-void LEDEffectCycle(void);
-void LEDEffectDisable(void);
+void LEDSchedule(void);
+uint16_t LEDGetFrameCount(void);
+uint16_t LEDGetSkipCount(void);
+void LEDProcess(const uint8_t effect, const uint8_t elapsed); // No bus access - output in g_leds
+uint8_t LEDEffectGetPeriod(const uint8_t effect);
+bool LEDEffectIsHue(const uint8_t effect);
+PGM_P LEDEffectGetName(const uint8_t effect);
+uint8_t LEDEffectGetId(const uint8_t effect);
+uint8_t LEDEffectFromId(const uint8_t id);
 
 #endif
@@ -37,21 +37,38 @@ extern bool IsInputIncrement(void); // Function
 extern bool IsInputSelect(void);    // Function
 extern bool IsInputUpdate(void);    // Function
 
+// Wait while button is in state - returns false if timeout (ms) elapsed first
+// Polls render LED frames, so the wait is timed rather than counted
+static bool WaitInputSelect(const bool state, const uint16_t timeout)
+{
+    uint32_t start = millis();
+
+    while (IsInputSelect() == state)
+    {
+        if ((millis() - start) >= timeout)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
 void MenuInfo(void)
 {
+#ifdef PROFILE
+    const uint8_t FUNCTION_COUNT = 3; // Hidden profiler page
+#else
+    const uint8_t FUNCTION_COUNT = 2;
+#endif
     uint8_t function = 0;
-    uint32_t timeout = Timeout::INFO;
-
-    while (IsInputSelect() && --timeout);
 
-    if (timeout)
+    if (WaitInputSelect(true, Timeout::INFO))
     {
         do
         {
-            timeout = Timeout::INFO;
-            while (!IsInputSelect() && --timeout);
-            
-            if (!timeout)
+            if (!WaitInputSelect(false, Timeout::INFO))
             {
                 break;
             }
@@ -63,20 +80,24 @@ void MenuInfo(void)
                 g_display.SetUnitValue(4, '@' + VERSION);
                 break;
             case 1:
+#ifdef PROFILE
+                MenuProfile();
+                break;
+            case 2:
+#endif
                 RestoreOutOfBox();
                 break;
             }
 
             function++;
-            timeout = Timeout::INFO;
-            while (IsInputSelect() && --timeout); // Wait until release
             
-            if (!timeout)
+            if (!WaitInputSelect(true, Timeout::INFO)) // Wait until release
             {
                 Detonate();
+                break;
             }
         }
-        while ((function < 2) && timeout);
+        while (function < FUNCTION_COUNT);
     }
     else
     {
@@ -85,6 +106,56 @@ void MenuInfo(void)
 }
 
 
+#ifdef PROFILE
+// Page format: [slot][field][value]
+// Slot:  A = Display ISR, B = Tick ISR, C = Main loop, D = Note tap,
+//        E = Music start, F+ = LED effect
+// Field: L = Min (us), A = Avg (us), H = Max (us), o = Overrun count
+// Last page: SF = Lowest free SRAM between static data and stack (bytes)
+void MenuProfile(void)
+{
+    const char field_char[PROFILE_FIELD_COUNT] = {'L', 'A', 'H', 'o'};
+    const uint8_t page_stack = (PROFILE_COUNT * PROFILE_FIELD_COUNT);
+    const uint8_t page_count = (page_stack + 1);
+    char s[DISPLAY_COUNT + 1];
+    uint8_t page = 0;
+    uint32_t start = millis();
+    
+    ProfileDump(); // Send snapshot over serial when enabled
+    
+    while (IsInputSelect()); // Wait until release
+    IsInputUpdate(); // Clear any pending interrupt
+
+    do
+    {
+        if (IsInputUpdate())
+        {
+            page = (IsInputIncrement() ? (page + 1) : (page + page_count - 1)) % page_count;
+            start = millis();
+        }
+        
+        uint8_t slot = (page / PROFILE_FIELD_COUNT);
+        uint8_t field = (page % PROFILE_FIELD_COUNT);
+        
+        if (page == page_stack)
+        {
+            snprintf_P(s, DISPLAY_COUNT + 1, PSTR("SF%4u"), ProfileGetStackFree());
+        }
+        else
+        {
+            uint16_t value = ProfileGetValue(slot, field);
+            snprintf_P(s, DISPLAY_COUNT + 1, PSTR("%c%c%4u"), 'A' + slot,
+                       field_char[field], (value > 9999) ? 9999 : value);
+        }
+        
+        g_display.SetDisplayValue(s);
+        delay(50);
+    }
+    while (!IsInputSelect() && ((millis() - start) < Timeout::PAGE));
+}
+#endif
+
+
 void MenuSettings(void)
 {
     // Use full brightness for Menu
@@ -170,7 +241,7 @@ void MenuSettings(void)
         case MENU_ITEM_LED:
             if (SetLEDEffect())
             {
-                if (g_config.led_effect < LED_EFFECT_PONG)
+                if (LEDEffectIsHue(g_config.led_effect))
                 {
                     SetLEDHue();
                 }
@@ -886,9 +957,14 @@ bool SetLEDEffect(void)
     prompt_select.display_mode = CDisplay::Mode::SCROLL;
     prompt_select.title = F("Effect");
 
-    // Copy item table to local variable
-    char* array[sizeof(LEDEffect_item_array) / sizeof(char*)];
-    memcpy_P(array, LEDEffect_item_array, sizeof(array));
+    // Copy item names from effect registry
+    PGM_P array[LED_EFFECT_COUNT];
+    
+    for (uint8_t effect = 0; effect < LED_EFFECT_COUNT; effect++)
+    {
+        array[effect] = LEDEffectGetName(effect);
+    }
+    
     prompt_select.item_array = reinterpret_cast<type_const_char_ptr*>(array);
     
     int8_t selection = g_display.PromptSelect(prompt_select, Timeout::SELECT * 2,
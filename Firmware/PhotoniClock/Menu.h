@@ -30,16 +30,18 @@
  
 #include "PhotoniClock.h"
 #include "LEDEffect.h"
+#include "Profile.h"
 
 typedef type_array type_const_char_ptr;
 typedef type_item type_const_uint8;
 
 enum Timeout : uint32_t
 {
-    INFO   = 200000,
+    INFO   =   2000, // ms
     MENU   =    150,
     SELECT =    500,
     VALUE  =   5000,
+    PAGE   =  60000, // ms
 };
 
 // Menu order determined by enum order
@@ -82,6 +84,9 @@ static PGM_P const menu_item_array[MENU_ITEM_COUNT] PROGMEM =
 
 void MenuInfo(void);
 void MenuSettings(void);
+#ifdef PROFILE
+void MenuProfile(void);
+#endif
 int8_t SelectCycle(const Cycle init_value);
 int8_t SelectState(CDisplay::PromptSelectStruct& prompt_select);
 bool SelectRTCValue(CDisplay::PromptValueStruct& prompt_value);
@@ -27,102 +27,456 @@
  */
 
 #include "Music.h"
+#include "Bus.h"
+#include "Profile.h"
 
 extern CAudio g_audio;
 extern CEEPROM g_eeprom;
 
-static const uint16_t BUFFER_SIZE = 32;
-static const uint16_t PADDED_BUFFER_SIZE = (BUFFER_SIZE * 3) + 1; //32*3 + an end
-static uint8_t music_channel_A[PADDED_BUFFER_SIZE] = { NOTE::END };
-static uint8_t music_channel_B[PADDED_BUFFER_SIZE] = { NOTE::END };
-static I2CStreamData I2CStreamA = {music_channel_A, &music_channel_A[BUFFER_SIZE], &music_channel_A[BUFFER_SIZE * 2]};
-static I2CStreamData I2CStreamB = {music_channel_B, &music_channel_B[BUFFER_SIZE], &music_channel_A[BUFFER_SIZE * 2]};
+// Decoder relies on token values matching nAudio
+static_assert(NOTE::NC2 == NOTE_CODEC_PITCH_MIN, "Codec pitch range mismatch");
+static_assert(NOTE::NB8 == NOTE_CODEC_PITCH_MAX, "Codec pitch range mismatch");
+static_assert(NOTE::TEMPO == NOTE_CODEC_TEMPO, "Codec tempo mismatch");
+static_assert(DURATION::DTS == NOTE_CODEC_DURATION, "Codec duration mismatch");
+static_assert(DURATION::DW == (NOTE_CODEC_DURATION + NOTE_CODEC_DURATION_COUNT - 1), "Codec duration mismatch");
+static_assert(MUSIC_LOOP == NOTE_CODEC_LOOP, "Codec loop mismatch");
+static_assert(MUSIC_LOOP > DURATION::DBLIP, "Opcodes must not overlap nAudio tokens");
 
-void I2CStreamACallback(const uint8_t err)
+struct PGMStreamData
 {
-    if(err == 0)
+    const uint8_t* data = nullptr;
+    NoteTap tap;
+};
+
+/* === Prefetch Ring ===
+
+ Each channel holds a ring of blocks of BUFFER_SIZE bytes. Stored bytes
+ are only read forward - look-ahead re-reads are served from the phrase
+ window - so every slot but the current block is requested ahead, one
+ read in flight
+
+ When the current block has not arrived, a rest is returned in place
+ of the next token and the song resumes where it left off once loaded.
+ A TEMPO and its operand are served together so a rest never splits them
+
+ From REFILL_POINT of a block whose end makes the next read due, audio
+ holds bus priority until that read is queued (see Bus.cpp)
+=============================*/
+
+static const uint16_t BUFFER_SIZE = 32; // Must be a power of 2
+static const uint8_t SLOT_COUNT = 2; // Default ring depth (blocks) - current and next
+static const uint8_t REFILL_POINT = (BUFFER_SIZE - 2); // Block offset where the next read is imminent
+static uint16_t music_underrun = 0; // Rests inserted
+static uint16_t music_late = 0; // Blocks that arrived after they were needed
+
+// Directory entries of recently played EEPROM songs
+struct SongEntry
+{
+    uint8_t index;
+    uint16_t start[Music::CHANNEL_COUNT];
+    uint16_t length[Music::CHANNEL_COUNT];
+    uint8_t compressed; // Channel bitmask
+    uint8_t checksum; // Must be last
+};
+
+static const uint8_t SONG_CACHE_COUNT = (ALARM_COUNT + 1); // Alarms and timer
+static SongEntry song_cache[SONG_CACHE_COUNT];
+static uint8_t song_cache_next = 0;
+
+#ifdef PROFILE
+static uint16_t music_start = 0; // Timestamp of PlayMusic
+static bool music_starting = false;
+#endif
+
+// Record latency from PlayMusic to first byte served to audio
+static inline void MusicStarted(const uint16_t offset) __attribute__((always_inline));
+static inline void MusicStarted(const uint16_t offset)
+{
+#ifdef PROFILE
+    if(music_starting && (offset == 0))
     {
-        I2CStreamA.valid = true;
+        music_starting = false;
+        ProfileRecord(PROFILE_MUSIC_START, ProfileTimestamp() - music_start);
     }
-    else
-    {    
-        //Abandon all hope ye who enter here
-        //(bail on error)
-        asm volatile ("jmp 0");
+#endif
+}
+static PGMStreamData PGMStreamA;
+static PGMStreamData PGMStreamB;
+
+// Note event ring - head written only by stream, tail only by consumer
+static NoteEvent note_event[NOTE_EVENT_COUNT];
+static volatile uint8_t note_event_head = 0;
+static volatile uint8_t note_event_tail = 0;
+static uint16_t note_event_count = 0;
+static uint16_t note_event_drop = 0;
+static uint8_t note_event_latency = 0; // Maximum (ms)
+
+// Publish note read by stream - called from audio context
+// Look-ahead re-reads earlier offsets so only new offsets are published
+static void NoteEventTap(NoteTap& tap, const uint16_t offset, const uint8_t value)
+{
+    PROFILE_BEGIN(tap);
+    
+    if (offset < tap.next)
+    {
+        return; // Already published
+    }
+    
+    tap.next = offset + 1;
+    uint8_t previous = tap.previous;
+    tap.previous = value;
+    
+    if (previous == NOTE::TEMPO)
+    {
+        return; // Operand of tempo change
+    }
+    
+    if (value >= DURATION::DTS)
+    {
+        tap.duration = value;
     }
+    else if ((value != NOTE::NRS) && (value < NOTE::END))
+    {
+        uint8_t head = note_event_head;
+        uint8_t next = (head + 1) & (NOTE_EVENT_COUNT - 1);
+        
+        if (next == note_event_tail)
+        {
+            note_event_drop++; // Full - consumer not keeping up
+        }
+        else
+        {
+            note_event[head] = {value, tap.duration, tap.channel, (uint8_t)millis()};
+            note_event_head = next; // Publish after event is written
+            note_event_count++;
+        }
+    }
+    
+    PROFILE_END(tap, PROFILE_NOTE_TAP);
 }
 
-void I2CStreamBCallback(const uint8_t err)
+
+// Channels at refill point - audio holds bus priority while non-zero
+static uint8_t music_refill = 0;
+
+// Read failure is retried by stream - playback rests meanwhile
+static void I2CStreamLoaded(I2CStreamData& stream, const uint8_t err)
 {
     if(err == 0)
     {
-        I2CStreamB.valid = true;
+        stream.ready++;
+        
+        if(stream.starved)
+        {
+            stream.starved = false;
+            music_late++;
+        }
     }
     else
-    {    
-        //Abandon all hope ye who enter here
-        //(bail on error)
-        asm volatile ("jmp 0");
+    {
+        stream.loaded = stream.ready; //Request block again
     }
+    
+    stream.busy = false;
 }
 
-static uint8_t I2CStream(uint16_t offset, void* data)
+//Mark channel pending from refill point until its read is queued
+static void I2CStreamRefill(I2CStreamData* stream, const bool refill)
 {
-    I2CStreamData* stream = ((I2CStreamData*) data);
-    if(offset > (stream->length + 1))
+    uint8_t mask = (1 << stream->tap.channel);
+    uint8_t previous = music_refill;
+    
+    if(refill)
+    {
+        music_refill |= mask;
+    }
+    else
+    {
+        music_refill &= ~mask;
+    }
+    
+    //Only changes are passed on - the arbiter stamps once per refill and
+    //releases a song stopped mid-refill after its timeout
+    if((previous == 0) != (music_refill == 0))
     {
-        //Done
-        return NOTE::END;
+        BusPending(BUS_PRIORITY_AUDIO, (music_refill != 0));
     }
+}
 
-    //Rotate the buffers if necessary (at beginning of next buffer)
-    if(offset == (stream->pos + BUFFER_SIZE))
+// Keep ring filled up to watermark ahead of block
+static void I2CStreamPrefetch(I2CStreamData* stream, const uint16_t position)
+{
+    uint16_t block = (position / BUFFER_SIZE);
+    bool more = ((stream->loaded * BUFFER_SIZE) < stream->length);
+    bool due = more && (stream->loaded < (block + stream->slots));
+    
+    if(due && !stream->busy)
     {
-        if(!stream->valid)
+        uint16_t address = (stream->loaded * BUFFER_SIZE);
+        uint16_t remaining = min((uint16_t)(stream->length - address), BUFFER_SIZE);
+        uint8_t* slot = &stream->buffer[(stream->loaded & (stream->slots - 1)) * BUFFER_SIZE];
+
+        BusRequest(BUS_PRIORITY_AUDIO); //Highest priority - always granted
+        
+        //Attempt to load block, otherwise retry the read next call
+        if(g_eeprom.Read(stream->start + address, slot, remaining, stream->callback) == 0)
         {
-            //Didn't load in time, abort and reset
-            //TODO: maybe should return NOTE::END instead?
-            asm volatile ("jmp 0");
+            stream->busy = true;
+            stream->loaded++;
+            due = false; //Queued ahead of later frames
         }
+    }
+    
+    //Next block boundary makes a read due - hold off frames from refill point
+    bool refill = due || (more && !stream->busy && (stream->loaded == (block + stream->slots)) && ((position % BUFFER_SIZE) >= REFILL_POINT));
+    I2CStreamRefill(stream, refill);
+}
+
+//Stored byte at position - false if block has not arrived
+static bool I2CStreamByte(I2CStreamData* stream, const uint16_t position, uint8_t& value)
+{
+    uint16_t block = (position / BUFFER_SIZE);
+    
+    I2CStreamPrefetch(stream, position);
+    
+    if(block >= stream->ready)
+    {
+        return false;
+    }
+    
+    value = stream->buffer[((block & (stream->slots - 1)) * BUFFER_SIZE) + (position % BUFFER_SIZE)];
+    return true;
+}
 
-        uint8_t* temp = stream->prev;
-        stream->prev = stream->data;
-        stream->data = stream->next;
-        stream->next = temp;
-        stream->pos = offset; //Set position to beginning of second buffer
-        stream->valid = false;
-        stream->loadNext = true; //We need to load the buffer
+//Underrun - rest in place of next token rather than reset
+static uint8_t I2CStreamRest(I2CStreamData* stream, const uint16_t offset)
+{
+    if(offset != stream->rest_end)
+    {
+        stream->rest_begin = offset; //Start of new run
+        stream->rest_end = offset;
     }
+    
+    stream->rest_end++;
+    stream->skew++;
+    stream->starved = true;
+    music_underrun++;
+    BusLate(BUS_PRIORITY_AUDIO);
+    return NOTE::NRS;
+}
 
-    //Load next buffer if necessary (beginning of buffer or failed last attempt)
-    if(stream->loadNext)
+//Next stored token - false if block has not arrived
+static bool I2CStreamToken(I2CStreamData* stream, uint8_t& token)
+{
+    if(stream->compressed)
     {
-        uint32_t remaining = stream->length - offset;
-        if(remaining >= BUFFER_SIZE)
+        //Decode until token is available
+        while(stream->decoder.Count() <= stream->token)
         {
-            remaining = BUFFER_SIZE;
+            uint8_t byte;
+            
+            if(stream->cursor >= stream->length)
+            {
+                //Done
+                token = NOTE::END;
+                return true;
+            }
+            
+            if(!I2CStreamByte(stream, stream->cursor, byte))
+            {
+                return false;
+            }
+            
+            stream->decoder.Push(byte);
+            stream->cursor++;
         }
+        
+        token = stream->decoder.Token(stream->token);
+    }
+    else
+    {
+        if(stream->token >= stream->length)
+        {
+            //Done
+            token = NOTE::END;
+            return true;
+        }
+        
+        if(!I2CStreamByte(stream, stream->token, token))
+        {
+            return false;
+        }
+    }
+    
+    stream->token++;
+    return true;
+}
+
+/* === Phrase Loops ===
+
+ Stored tokens pass through a loop interpreter before playback
+
+ LOOP n ... LOOP_END    Section played (n + 1) times, nests PHRASE_DEPTH
+ PHRASE                 Outermost section played once more
+
+ Tokens of open sections are captured in the channel cache as they are
+ read, so repeats do not read EEPROM again. The packer rejects sections
+ longer than PHRASE_SIZE - one that reaches the device anyway plays once
+
+ The last PHRASE_WINDOW output tokens are kept for look-ahead re-reads
+=============================*/
+
+static void NoteSequenceEmit(NoteSequence& sequence, const uint8_t token)
+{
+    sequence.window[sequence.count++ & (PHRASE_WINDOW - 1)] = token;
+}
 
-        //Attempt to load next buffer
-        if(g_eeprom.Read(stream->start + stream->pos + BUFFER_SIZE, stream->next, remaining, stream->callback) == 0)
+//Interpret next token of loops - false if block has not arrived
+static bool I2CStreamSequence(I2CStreamData* stream)
+{
+    NoteSequence& sequence = stream->sequence;
+    uint8_t token;
+    
+    if(sequence.read < sequence.fill)
+    {
+        //Replay section from cache
+        token = sequence.cache[sequence.read++];
+    }
+    else
+    {
+        if(!I2CStreamToken(stream, token))
         {
-            stream->loadNext = false;
+            return false;
         }
-        else
+        
+        //Capture open sections for replay
+        if(sequence.depth)
+        {
+            if(sequence.fill < PHRASE_SIZE)
+            {
+                sequence.cache[sequence.fill++] = token;
+            }
+            else
+            {
+                sequence.valid = false; //Section too long - play once
+            }
+            
+            sequence.read = sequence.fill;
+        }
+    }
+    
+    if(sequence.pass)
+    {
+        sequence.pass = false;
+        NoteSequenceEmit(sequence, token);
+    }
+    else if(sequence.operand)
+    {
+        sequence.operand = false;
+        
+        if(sequence.depth == 0)
+        {
+            //New outermost section replaces cache
+            sequence.fill = sequence.read = 0;
+            sequence.valid = true;
+        }
+        
+        if(sequence.depth < PHRASE_DEPTH)
+        {
+            sequence.frame[sequence.depth] = {sequence.read, token};
+        }
+        
+        sequence.depth++;
+    }
+    else if(token == NOTE::TEMPO)
+    {
+        sequence.pass = true;
+        NoteSequenceEmit(sequence, token);
+    }
+    else if(token == MUSIC_LOOP)
+    {
+        sequence.operand = true;
+    }
+    else if(token == MUSIC_LOOP_END)
+    {
+        if(sequence.depth)
+        {
+            PhraseFrame& frame = sequence.frame[min(sequence.depth, PHRASE_DEPTH) - 1];
+            
+            if(sequence.valid && (sequence.depth <= PHRASE_DEPTH) && frame.count)
+            {
+                frame.count--;
+                sequence.read = frame.start;
+            }
+            else
+            {
+                sequence.depth--;
+            }
+        }
+    }
+    else if(token == MUSIC_PHRASE)
+    {
+        if(sequence.valid && (sequence.depth == 0))
         {
-            //Something went wrong, retry the read next call
-            stream->loadNext = true;
+            sequence.frame[0] = {0, 0};
+            sequence.depth = 1;
+            sequence.read = 0;
         }
     }
+    else
+    {
+        NoteSequenceEmit(sequence, token);
+    }
+    
+    return true;
+}
 
-    if(offset >= stream->pos)
+static uint8_t I2CStream(uint16_t offset, void* data)
+{
+    I2CStreamData* stream = ((I2CStreamData*) data);
+    uint16_t position;
+    uint8_t value;
+    
+    MusicStarted(offset);
+    
+    //Map stream offset to song position around inserted rests
+    if(offset < stream->rest_begin)
     {
-        return stream->data[offset % BUFFER_SIZE];
+        position = offset - (stream->skew - (stream->rest_end - stream->rest_begin));
+    }
+    else if(offset < stream->rest_end)
+    {
+        return NOTE::NRS;
     }
     else
     {
-        return stream->prev[offset % BUFFER_SIZE];
+        position = offset - stream->skew;
     }
+    
+    //Interpret until token at position is available - TEMPO is held back
+    //until its operand is, so a rest lands before it rather than between
+    while((stream->sequence.count <= position) || ((stream->sequence.count == (position + 1)) && stream->sequence.pass))
+    {
+        if(!I2CStreamSequence(stream))
+        {
+            return I2CStreamRest(stream, offset);
+        }
+    }
+    
+    value = stream->sequence.window[position & (PHRASE_WINDOW - 1)];
+    
+    NoteEventTap(stream->tap, offset, value);
+    return value;
+}
+
+// Equivalent to CAudio::Functions::PGMStream with note event tap
+static uint8_t PGMStream(uint16_t offset, void* data)
+{
+    PGMStreamData* stream = ((PGMStreamData*) data);
+    MusicStarted(offset);
+    uint8_t value = pgm_read_byte(&stream->data[offset]);
+    NoteEventTap(stream->tap, offset, value);
+    return value;
 }
 
 uint8_t* GetMusicDATA(const uint8_t index, const uint8_t channel)
@@ -130,78 +484,289 @@ uint8_t* GetMusicDATA(const uint8_t index, const uint8_t channel)
     return reinterpret_cast<uint8_t*>(pgm_read_word(&(music_list[index][channel])));
 }
 
-uint8_t GetMusicEEPROM(const uint8_t index, const uint8_t channel, I2CStreamData* stream)
+// Read channel location from offset table
+static uint8_t ReadMusicDirectory(const uint8_t index, const uint8_t channel, uint16_t& start, uint16_t& length, bool& compressed)
 {
-    uint8_t status = 0;
-    uint32_t start = 0;
-    uint32_t end = 0;
-    uint8_t channel_offset = 0;
     uint8_t offset[Music::ADDRESS_SIZE * 2];
-
+    
     // Channels may be duplicates. Continue until non-duplicate channel to calculate length
-    while((stream->length == 0) || (status != 0))
+    for(uint8_t entry = ((index * Music::CHANNEL_COUNT) + channel); entry < UINT8_MAX; entry++)
     {
-        start = 0;
-        end = 0;
-        
         // Calculate offset address
-        uint32_t address = ((Music::ADDRESS_SIZE * ((index * Music::CHANNEL_COUNT) + channel + channel_offset)) + Music::ADDRESS_SIZE);
-        channel_offset++;
+        uint32_t address = ((Music::ADDRESS_SIZE * entry) + Music::ADDRESS_SIZE);
         
         // Read offsets from EEPROM
-        status |= g_eeprom.Read(address, offset, sizeof(offset));
+        if(g_eeprom.Read(address, offset, sizeof(offset)) != 0)
+        {
+            return 1; // Error
+        }
+        
+        uint16_t end = 0;
+        start = 0;
+        
+        // Calculate start and end offsets
+        for(uint8_t offset_index = 0; offset_index < Music::ADDRESS_SIZE; offset_index++)
+        {
+            start |= (offset[offset_index] << (8 * offset_index));
+            end |= (offset[offset_index + Music::ADDRESS_SIZE] << (8 * offset_index));
+        }
+        
+        // Offsets are flagged by compressed entries
+        compressed = (start & Music::COMPRESSED);
+        start &= ~Music::COMPRESSED;
+        length = (end & ~Music::COMPRESSED) - start;
+        
+        if(length != 0)
+        {
+            return 0;
+        }
+    }
+    
+    return 1; // Table end not found
+}
+
+static uint8_t SongChecksum(const SongEntry& song)
+{
+    const uint8_t* byte = reinterpret_cast<const uint8_t*>(&song);
+    uint8_t sum = 0;
+    
+    for(uint8_t index = 0; index < (sizeof(SongEntry) - 1); index++)
+    {
+        sum += byte[index];
+    }
+    
+    return ~sum; // Zeroed entry is invalid
+}
 
-        if(status == 0)
+// Return directory entry of EEPROM song - read once then served from cache
+static const SongEntry* GetMusicSong(const uint8_t index)
+{
+    SongEntry* song = nullptr;
+    
+    for(uint8_t entry = 0; entry < SONG_CACHE_COUNT; entry++)
+    {
+        if(song_cache[entry].index == index)
         {
-            // Calculate start and end offsets
-            for(uint8_t offset_index = 0; offset_index < Music::ADDRESS_SIZE; offset_index++)
+            song = &song_cache[entry];
+            
+            if(song->checksum == SongChecksum(*song))
             {
-                start |= (offset[offset_index] << (8 * offset_index));
-                end |= (offset[offset_index + Music::ADDRESS_SIZE] << (8 * offset_index));
+                return song; // Hit
             }
+            
+            break; // Corrupt - reload in place
+        }
+    }
+    
+    if(song == nullptr)
+    {
+        song = &song_cache[song_cache_next]; // Replace oldest
+        song_cache_next = (song_cache_next + 1) % SONG_CACHE_COUNT;
+    }
+    
+    song->index = index;
+    song->compressed = 0;
+    
+    for(uint8_t channel = 0; channel < Music::CHANNEL_COUNT; channel++)
+    {
+        bool compressed;
+        
+        if(ReadMusicDirectory(index, channel, song->start[channel], song->length[channel], compressed) != 0)
+        {
+            song->checksum = ~SongChecksum(*song); // Invalidate
+            return nullptr;
         }
+        
+        song->compressed |= (compressed << channel);
+    }
+    
+    song->checksum = SongChecksum(*song);
+    return song;
+}
 
-        //Set up stream data
-        stream->start = start;
-        stream->length = end - start;
+uint8_t GetMusicEEPROM(const uint8_t index, const uint8_t channel, I2CStreamData* stream)
+{
+    uint8_t status = 0;
+    const SongEntry* song = GetMusicSong(index);
+    
+    if(song == nullptr)
+    {
+        return 1; // Error - stream plays nothing
     }
+    
+    //Set up stream data
+    stream->start = song->start[channel];
+    stream->length = song->length[channel];
+    stream->compressed = (song->compressed & (1 << channel));
 
-    //Load first buffer
+    //Load first block - stream requests it again on failure
     if(stream->length >= BUFFER_SIZE)
     {
-        status |= g_eeprom.Read(stream->start, stream->data, BUFFER_SIZE);
+        status |= g_eeprom.Read(stream->start, stream->buffer, BUFFER_SIZE);
     }
     else
     {
-        status |= g_eeprom.Read(stream->start, stream->data, stream->length);
+        status |= g_eeprom.Read(stream->start, stream->buffer, stream->length);
+    }
+    
+    if(status == 0)
+    {
+        stream->loaded = stream->ready = 1;
     }
 
     return status;
 }
 
 
+// Per channel storage and read callback for EEPROM stream
+template<uint8_t CHANNEL, uint8_t SLOTS = SLOT_COUNT>
+class CI2CStream
+{
+    static_assert(CHANNEL < Music::CHANNEL_COUNT, "Channel not in EEPROM format");
+    static_assert((SLOTS >= 2) && !(SLOTS & (SLOTS - 1)), "Ring must be a power of 2 with room to prefetch");
+
+    public:
+
+    // Reset stream and load first block of song
+    static I2CStreamData* Load(const uint8_t index)
+    {
+        m_stream = {m_buffer, SLOTS};
+        m_stream.callback = Callback;
+        m_stream.tap.channel = CHANNEL;
+        GetMusicEEPROM(index, CHANNEL, &m_stream);
+        return &m_stream;
+    }
+
+    private:
+
+    static void Callback(const uint8_t err)
+    {
+        I2CStreamLoaded(m_stream, err);
+    }
+
+    static uint8_t m_buffer[SLOTS * BUFFER_SIZE];
+    static I2CStreamData m_stream;
+};
+
+template<uint8_t CHANNEL, uint8_t SLOTS> uint8_t CI2CStream<CHANNEL, SLOTS>::m_buffer[SLOTS * BUFFER_SIZE];
+template<uint8_t CHANNEL, uint8_t SLOTS> I2CStreamData CI2CStream<CHANNEL, SLOTS>::m_stream;
+
 //TODO: can't use nullptr to disable stream anymore, have to use nullstream
 void PlayMusic(const uint8_t index)
 {
-    using streams = CAudio::Functions;
+#ifdef PROFILE
+    music_start = ProfileTimestamp();
+    music_starting = true;
+#endif
+    
+    NoteEventFlush(); // Discard events of previous song
+    
+    cli();
+    music_refill = 0;
+    BusPending(BUS_PRIORITY_AUDIO, false);
+    sei();
+    
     // Entries < INBUILT_SONG_COUNT are stored in DATA
     if (index < INBUILT_SONG_COUNT)
     {
-        g_audio.Play(streams::PGMStream, GetMusicDATA(index, 0), GetMusicDATA(index, 1));
+        PGMStreamA = PGMStreamData();
+        PGMStreamB = PGMStreamData();
+        PGMStreamA.data = GetMusicDATA(index, 0);
+        PGMStreamB.data = GetMusicDATA(index, 1);
+        PGMStreamB.tap.channel = 1;
+        
+        g_audio.Play(PGMStream, &PGMStreamA, &PGMStreamB);
     }
     else
     {
-        //Reset stream data
-        I2CStreamA = {music_channel_A, &music_channel_A[BUFFER_SIZE], &music_channel_A[BUFFER_SIZE * 2]};
-        I2CStreamB = {music_channel_B, &music_channel_B[BUFFER_SIZE], &music_channel_B[BUFFER_SIZE * 2]};
-        I2CStreamA.callback = I2CStreamACallback;
-        I2CStreamB.callback = I2CStreamBCallback;
-
-        //Fill out the stream information
-        GetMusicEEPROM(index - INBUILT_SONG_COUNT, 0, &I2CStreamA);
-        GetMusicEEPROM(index - INBUILT_SONG_COUNT, 1, &I2CStreamB);
+        //Reset stream data and fill out the stream information
+        I2CStreamData* stream_A = CI2CStream<0>::Load(index - INBUILT_SONG_COUNT);
+        I2CStreamData* stream_B = CI2CStream<1>::Load(index - INBUILT_SONG_COUNT);
 
         //Play streams
-        g_audio.Play(I2CStream, &I2CStreamA, &I2CStreamB);
+        g_audio.Play(I2CStream, stream_A, stream_B);
+    }
+}
+
+
+// Consume oldest note event - returns false if none pending
+bool NoteEventRead(NoteEvent& event)
+{
+    uint8_t tail = note_event_tail;
+    
+    if (tail == note_event_head)
+    {
+        return false;
+    }
+    
+    event = note_event[tail];
+    note_event_tail = (tail + 1) & (NOTE_EVENT_COUNT - 1); // Release slot after copy
+    
+    uint8_t latency = (uint8_t)millis() - event.stamp;
+    
+    if (latency > note_event_latency)
+    {
+        note_event_latency = latency;
+    }
+    
+    return true;
+}
+
+
+// Consumer side - discard pending events
+void NoteEventFlush(void)
+{
+    note_event_tail = note_event_head;
+}
+
+
+uint16_t NoteEventGetCount(void)
+{
+    cli(); // Written from audio context
+    uint16_t count = note_event_count;
+    sei();
+    return count;
+}
+
+
+uint16_t NoteEventGetDropCount(void)
+{
+    cli(); // Written from audio context
+    uint16_t count = note_event_drop;
+    sei();
+    return count;
+}
+
+
+uint8_t NoteEventGetLatency(void)
+{
+    return note_event_latency;
+}
+
+
+uint16_t MusicGetUnderrunCount(void)
+{
+    cli(); // Written from audio context
+    uint16_t count = music_underrun;
+    sei();
+    return count;
+}
+
+
+uint16_t MusicGetLateCount(void)
+{
+    cli(); // Written from audio context
+    uint16_t count = music_late;
+    sei();
+    return count;
+}
+
+
+// Read directory entry ahead of first play - index as PlayMusic
+void MusicCacheSong(const uint8_t index)
+{
+    if (index >= INBUILT_SONG_COUNT)
+    {
+        GetMusicSong(index - INBUILT_SONG_COUNT);
     }
 }
@@ -32,12 +32,14 @@
 #include <nEEPROM.h>
 #include <nAudio.h>
 #include <nDisplay.h>
+#include "NoteCodec.h"
 
 enum Music : uint16_t
 {
     OFFSET = 256,
     ADDRESS_SIZE = 2,
     CHANNEL_COUNT = 2,
+    COMPRESSED = 0x8000, // Entry offset flag - limits data to 32KB
 };
 
 static const uint8_t music_blip[] = { 1, NC8, DBLIP, END };
@@ -77,20 +79,92 @@ static const uint8_t* const music_list[][2] PROGMEM =
 
 const uint8_t INBUILT_SONG_COUNT = (sizeof(music_list) / sizeof(music_list[0]));
 
+// Structural opcodes of EEPROM songs - values unused by nAudio
+enum MUSIC_OPCODE : uint8_t
+{
+    MUSIC_LOOP = 108,       // Operand follows - additional plays of section
+    MUSIC_LOOP_END = 109,
+    MUSIC_PHRASE = 110,     // Play last outermost section once more
+};
+
+const uint8_t PHRASE_SIZE = 32;     // Section tokens cached per channel (including LOOP_END)
+const uint8_t PHRASE_DEPTH = 2;     // Nested sections
+const uint8_t PHRASE_WINDOW = 16;   // Output kept for look-ahead re-reads - must be a power of 2
+
+struct PhraseFrame
+{
+    uint8_t start;  // Cache index of section body
+    uint8_t count;  // Plays remaining
+};
+
+// Loop interpreter - sections are replayed from SRAM rather than EEPROM
+struct NoteSequence
+{
+    uint8_t cache[PHRASE_SIZE];
+    uint8_t fill = 0; // Tokens cached
+    uint8_t read = 0; // Next cached token - replaying while less than fill
+    PhraseFrame frame[PHRASE_DEPTH];
+    uint8_t depth = 0; // Open sections - frames beyond PHRASE_DEPTH are not kept
+    bool valid = false; // Cache holds complete outermost section
+    bool pass = true; // Next token is tempo value
+    bool operand = false; // Next token is operand of LOOP
+    uint8_t window[PHRASE_WINDOW];
+    uint16_t count = 0; // Tokens output
+};
+
+// Note published by the music stream - consumed by the Visualizer effect
+struct NoteEvent
+{
+    uint8_t pitch;      // NOTE value (rests are not published)
+    uint8_t duration;   // DURATION value in effect for the note
+    uint8_t channel;    // Audio channel
+    uint8_t stamp;      // Lower byte of millis() when published
+};
+
+const uint8_t NOTE_EVENT_COUNT = 8; // Ring size - must be a power of 2
+
+// Per channel stream position already published
+struct NoteTap
+{
+    uint16_t next = 1; // Offset 0 holds tempo
+    uint8_t channel = 0;
+    uint8_t duration = DURATION::DQ;
+    uint8_t previous = NOTE::NRS;
+};
+
 struct I2CStreamData
 {
-    uint8_t* prev; //Kept because of the look-ahead
-    uint8_t* data; //Operating on
-    uint8_t* next; //Writing into
+    uint8_t* buffer; //Ring of prefetch blocks
+    uint8_t slots = 0; //Ring size (power of 2)
     uint32_t start = 0;
     uint16_t length = 0;
-    uint16_t pos = 0;
+    uint16_t loaded = 0; //Blocks requested
+    volatile uint16_t ready = 0; //Blocks loaded
+    volatile bool busy = false; //Read in flight
+    bool starved = false; //Underrun waiting on read
+    uint16_t skew = 0; //Rests inserted before current offset
+    uint16_t rest_begin = 0; //Offsets of latest run of rests
+    uint16_t rest_end = 0;
+    bool compressed = false; //Stored in NoteCodec format
+    uint16_t cursor = 0; //Next stored byte to decode
+    uint16_t token = 0; //Next stored token
+    CNoteDecoder decoder;
+    NoteSequence sequence;
     void (*callback)(const uint8_t) = nullptr;
-    bool loadNext = true;
-    volatile bool valid = false;
+    NoteTap tap;
 };
 
-uint8_t GetMusicEEPROM(const uint8_t index, const uint8_t channel, const I2CStreamData* stream);
+uint8_t GetMusicEEPROM(const uint8_t index, const uint8_t channel, I2CStreamData* stream);
 void PlayMusic(const uint8_t index);
+void MusicCacheSong(const uint8_t index);
+uint16_t MusicGetUnderrunCount(void);
+uint16_t MusicGetLateCount(void);
+
+// Note events - single producer (stream) / single consumer (main context)
+bool NoteEventRead(NoteEvent& event);
+void NoteEventFlush(void);
+uint16_t NoteEventGetCount(void);
+uint16_t NoteEventGetDropCount(void);
+uint8_t NoteEventGetLatency(void);
 
 #endif
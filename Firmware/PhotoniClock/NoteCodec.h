@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026 PhotonicFusion LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *
+ * @file        NoteCodec.h
+ * @summary     Compressed note stream format and streaming decoder
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _NOTECODEC_H
+#define _NOTECODEC_H
+
+#include <stdint.h>
+
+// No platform dependencies - shared with host side packer
+// (Utilities/notes2eeprom.py mirrors the encoder side of this format -
+// Utilities/CodecBench plays its output back through this decoder)
+
+/* === Compressed Note Stream ===
+
+ Decodes to the token stream played by nAudio (tempo byte, then pitch,
+ duration, TEMPO operand and END tokens)
+
+ Byte        Meaning
+ 0x00-0x6B   Literal token
+ 0x6C-0xFB   Pitch and duration in one byte
+             code = PAIR + ((delta - DELTA_MIN) * DURATION_COUNT) + duration
+             delta is from previous pitch, emits pitch then duration
+ 0xFC-0xFD   Copy from window, operand byte follows
+             length   = COPY_MIN + ((code & 1) << 3) + (operand & 0x7)
+             distance = (operand >> 3) + 1 tokens back
+ 0xFE        Escape - next byte is literal token
+ 0xFF        Reserved
+
+ The first byte and the operand of TEMPO are always literal. Neither
+ the operand of TEMPO nor of LOOP is taken as the previous pitch
+
+ At most COPY_MAX tokens are emitted per byte, so a token stays in the
+ window for at least (WINDOW - COPY_MAX) tokens after it is requested
+=============================*/
+
+enum NOTE_CODEC : uint8_t
+{
+    NOTE_CODEC_PITCH_MIN        = 1,    // NC2
+    NOTE_CODEC_PITCH_MAX        = 84,   // NB8
+    NOTE_CODEC_TEMPO            = 94,
+    NOTE_CODEC_DURATION         = 95,   // DTS - first of DURATION_COUNT
+    NOTE_CODEC_DURATION_COUNT   = 12,
+    NOTE_CODEC_LOOP             = 108,  // MUSIC_LOOP - tokens from PAIR up are escaped
+    NOTE_CODEC_PAIR             = 108,
+    NOTE_CODEC_DELTA_MIN        = 6,    // Magnitude of most negative delta
+    NOTE_CODEC_DELTA_COUNT      = 12,
+    NOTE_CODEC_COPY             = 252,
+    NOTE_CODEC_ESCAPE           = 254,
+    NOTE_CODEC_WINDOW           = 32,   // Must be a power of 2
+    NOTE_CODEC_COPY_MIN         = 3,
+    NOTE_CODEC_COPY_MAX         = (NOTE_CODEC_COPY_MIN + 15),
+};
+
+static_assert((NOTE_CODEC_PAIR + (NOTE_CODEC_DELTA_COUNT * NOTE_CODEC_DURATION_COUNT)) == NOTE_CODEC_COPY,
+              "Pair codes must end at copy codes");
+
+class CNoteDecoder
+{
+    public:
+    
+    CNoteDecoder(void)
+    {
+        Reset();
+    }
+    
+    void Reset(void)
+    {
+        m_count = 0;
+        m_pitch = NOTE_CODEC_PITCH_MIN;
+        m_copy = 0;
+        m_literal = true; // Tempo byte
+        m_operand = true;
+    }
+    
+    // Decode one byte - tokens become available through Token()
+    void Push(const uint8_t byte)
+    {
+        if (m_literal)
+        {
+            m_literal = false;
+            Emit(byte);
+        }
+        else if (m_copy)
+        {
+            uint8_t length = NOTE_CODEC_COPY_MIN + ((m_copy & 0x1) << 3) + (byte & 0x7);
+            uint8_t distance = (byte >> 3) + 1;
+            m_copy = 0;
+            
+            while (length--)
+            {
+                Emit(m_window[(m_count - distance) & (NOTE_CODEC_WINDOW - 1)]);
+            }
+        }
+        else if (byte < NOTE_CODEC_PAIR)
+        {
+            Emit(byte);
+        }
+        else if (byte < NOTE_CODEC_COPY)
+        {
+            uint8_t code = byte - NOTE_CODEC_PAIR;
+            uint8_t delta = code / NOTE_CODEC_DURATION_COUNT;
+            Emit(m_pitch + delta - NOTE_CODEC_DELTA_MIN);
+            Emit(NOTE_CODEC_DURATION + (code - (delta * NOTE_CODEC_DURATION_COUNT)));
+        }
+        else if (byte < NOTE_CODEC_ESCAPE)
+        {
+            m_copy = byte; // Wait for operand
+        }
+        else
+        {
+            m_literal = true;
+        }
+    }
+    
+    // Number of tokens decoded
+    uint16_t Count(void) const
+    {
+        return m_count;
+    }
+    
+    // Token is valid while (Count() - index) <= WINDOW
+    uint8_t Token(const uint16_t index) const
+    {
+        return m_window[index & (NOTE_CODEC_WINDOW - 1)];
+    }
+    
+    private:
+    
+    void Emit(const uint8_t token)
+    {
+        // Operand of TEMPO is a value, not a pitch
+        if (m_operand)
+        {
+            m_operand = false;
+            m_literal = false; // Operand may have been copied
+        }
+        else if (token == NOTE_CODEC_TEMPO)
+        {
+            m_operand = true;
+            m_literal = true;
+        }
+        else if (token == NOTE_CODEC_LOOP)
+        {
+            m_operand = true;
+        }
+        else if ((token >= NOTE_CODEC_PITCH_MIN) && (token <= NOTE_CODEC_PITCH_MAX))
+        {
+            m_pitch = token;
+        }
+        
+        m_window[m_count++ & (NOTE_CODEC_WINDOW - 1)] = token;
+    }
+    
+    uint8_t m_window[NOTE_CODEC_WINDOW];
+    uint16_t m_count;
+    uint8_t m_pitch; // Previous pitch
+    uint8_t m_copy; // Copy code awaiting operand
+    bool m_literal; // Next byte is literal
+    bool m_operand; // Next token is TEMPO or LOOP operand
+};
+
+#endif
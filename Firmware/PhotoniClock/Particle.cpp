@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 PhotonicFusion LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Particle.cpp
+ * @summary     Fixed capacity particle engine for LED effects
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include "Particle.h"
+
+// Use free slot, otherwise replace dimmest particle
+int8_t ParticleSpawn(ParticlePool& pool, const int16_t position, const int16_t velocity,
+                     const uint16_t value, const uint16_t decay, const uint8_t hue, const uint8_t falloff)
+{
+    uint8_t slot = 0;
+    
+    for (uint8_t particle = 1; particle < ParticlePool::CAPACITY; particle++)
+    {
+        if (pool.value[particle] < pool.value[slot])
+        {
+            slot = particle;
+        }
+    }
+    
+    pool.position[slot] = constrain(position, -PARTICLE_POSITION_LIMIT, PARTICLE_POSITION_LIMIT);
+    pool.velocity[slot] = velocity;
+    pool.value[slot] = value;
+    pool.decay[slot] = decay;
+    pool.hue[slot] = hue;
+    pool.falloff[slot] = falloff;
+    
+    return slot;
+}
+
+
+void ParticleStep(ParticlePool& pool)
+{
+    for (uint8_t particle = 0; particle < ParticlePool::CAPACITY; particle++)
+    {
+        if (pool.value[particle] == 0)
+        {
+            continue; // Inactive
+        }
+        
+        int16_t position = pool.position[particle] + pool.velocity[particle];
+        pool.position[particle] = constrain(position, -PARTICLE_POSITION_LIMIT, PARTICLE_POSITION_LIMIT);
+        
+        uint16_t value = pool.value[particle];
+        pool.value[particle] = (value > pool.decay[particle]) ? (value - pool.decay[particle]) : 0;
+    }
+}
+
+
+// Additive and saturating - caller clears or fades leds beforehand
+void ParticleRender(const ParticlePool& pool, uint8_t leds[CLED::COUNT::LED])
+{
+    for (uint8_t particle = 0; particle < ParticlePool::CAPACITY; particle++)
+    {
+        uint8_t value = (pool.value[particle] >> 8);
+        uint8_t falloff = pool.falloff[particle];
+        
+        if (value == 0)
+        {
+            continue; // Inactive or too dim
+        }
+        
+        for (uint8_t pixel = 0; pixel < CLED::COUNT::RGB; pixel++)
+        {
+            uint16_t distance = abs((int16_t)(pixel << 8) - pool.position[particle]);
+            uint16_t drop = ((distance >> 8) * falloff) + (((distance & 0xFF) * falloff) >> 8);
+            
+            if (drop >= value)
+            {
+                continue; // Out of reach
+            }
+            
+            CRGB rgb;
+            CHSV hsv = {pool.hue[particle], 255, (uint8_t)(value - drop)};
+            CLED::HueToRGB(hsv, rgb);
+            
+            for (uint8_t channel = 0; channel < 3; channel++)
+            {
+                leds[(3 * pixel) + channel] = qadd8(leds[(3 * pixel) + channel], rgb[channel]);
+            }
+        }
+    }
+}
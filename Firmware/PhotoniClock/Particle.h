@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 PhotonicFusion LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Particle.h
+ * @summary     Fixed capacity particle engine for LED effects
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _PARTICLE_H
+#define _PARTICLE_H
+
+#include "LEDController.h"
+
+/* === Particle Model ===
+
+ Position, velocity, value and decay are 8.8 fixed point
+ Position is in pixels - off screen positions are valid
+ Velocity is in pixels per step, decay in value per step
+
+ Each particle is rendered to every pixel as:
+
+   level = value - (distance * falloff)
+
+ where distance is in pixels (fractional), so a falloff of 255 lights
+ a single pixel (anti-aliased) and smaller values widen the particle
+
+ Cost per render is bounded by CAPACITY * CLED::COUNT::RGB
+=============================*/
+
+// Struct of arrays - all fields valid when zeroed (inactive)
+struct ParticlePool
+{
+    static const uint8_t CAPACITY = 4;
+    
+    int16_t     position[CAPACITY]; // Pixels
+    int16_t     velocity[CAPACITY]; // Pixels per step
+    uint16_t    value[CAPACITY];    // Brightness - inactive when zero
+    uint16_t    decay[CAPACITY];    // Brightness lost per step
+    uint8_t     hue[CAPACITY];      // Color index (full saturation)
+    uint8_t     falloff[CAPACITY];  // Brightness lost per pixel from center
+};
+
+const int16_t PARTICLE_POSITION_LIMIT = (32 << 8); // Keeps distance within 16 bits
+
+int8_t ParticleSpawn(ParticlePool& pool, const int16_t position, const int16_t velocity,
+                     const uint16_t value, const uint16_t decay, const uint8_t hue, const uint8_t falloff);
+void ParticleStep(ParticlePool& pool);
+void ParticleRender(const ParticlePool& pool, uint8_t leds[CLED::COUNT::LED]);
+
+#endif
@@ -38,6 +38,7 @@
 #include <PCF2129.h>
 #include "LEDController.h"
 #include "Music.h"
+#include "HV5812.h"
 
 const uint8_t VERSION       = 3;
 const uint8_t DISPLAY_COUNT = 6;
@@ -99,6 +100,9 @@ enum digital_pin_t : uint8_t
     DIGITAL_PIN_TRANSDUCER_1 = A1,
 };
 
+// Display shift register chain
+typedef CHV5812<DIGITAL_PIN_CLOCK, DIGITAL_PIN_SDATA, DIGITAL_PIN_LATCH, DIGITAL_PIN_BLANK> CVFD;
+
 enum analog_pin_t : uint8_t
 {
     ANALOG_PIN_PHOTODIODE = A3,
@@ -106,10 +110,20 @@ enum analog_pin_t : uint8_t
 
 enum interrupt_speed_t : uint8_t
 {
-    INTERRUPT_FAST = 23, // 16MHz / (115Hz * 6 tubes * 8 levels * 128 prescale)
+    INTERRUPT_FAST = 4, // BCM LSB = (4 * 128 prescale) / 16MHz = 32us; 6 tubes * 63 LSB = 83Hz
     INTERRUPT_SLOW = 255,
 };
 
+// Binary code modulation bit-planes (64 brightness levels)
+const uint8_t BCM_PLANES = 6;
+const uint8_t BCM_DUTY_MAX = (1 << BCM_PLANES) - 1;
+
+// Duty cycle of each CDisplay::Brightness level
+static const uint8_t BCM_DUTY[9] PROGMEM =
+{
+    BCM_DUTY_MAX, 5, 11, 16, 21, 32, 37, 47, BCM_DUTY_MAX,
+};
+
 enum led_scale_t : uint8_t
 {
     LED_SCALE_R = 255,
@@ -162,7 +176,7 @@ struct StateStruct
     : voltage(State::DISABLE)
     , display(State::DISABLE)
     , alarm(State::DISABLE)
-    , leds(State::DISABLE) // Start disabled to prevent IRQ lock-up
+    , leds(State::DISABLE) // Start disabled until LED driver is initialized
     , menu(State::DISABLE)
     {
         // empty
@@ -232,6 +246,15 @@ struct Config
     char                    phrase[DISPLAY_COUNT + 1];
 };
 
+// Pre-rendered tube state consumed by the display interrupt
+struct TubeFrame
+{
+    uint16_t    pattern;    // Grid and anode bits in shift order (MSB first)
+    uint8_t     duty;       // Brightness as BCM bit-plane mask
+};
+
+const uint8_t TUBE_PATTERN_BITS = (DISPLAY_COUNT + 8); // Grid + anodes
+
 // Return integral value of Enumeration
 template<typename T> constexpr auto getValue(const T e) noexcept
 {
@@ -289,6 +312,9 @@ void VoltageState(const State state);
 void LEDState(const State state);
 void DisplayState(const State state);
 
+// Display functions
+void DisplayRender(void);
+
 // Interrupt functions
 void InterruptSpeed(const uint8_t speed);
 
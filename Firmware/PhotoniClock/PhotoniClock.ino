@@ -28,6 +28,8 @@
 #include "PhotoniClock.h"
 #include "Menu.h"
 #include "LEDEffect.h"
+#include "Profile.h"
+#include "Bus.h"
 
 //---------------------------------------------------------------------
 // Global Variables
@@ -51,10 +53,14 @@ CEEPROM         g_eeprom{CEEPROM::Address::A7, 64, 512}; // 32768 (64 * 512) byt
 // Container variables
 uint8_t         g_leds[CLED::COUNT::LED];
 CRTC::RTC*      g_rtc_struct;
+TubeFrame       g_frame[2][DISPLAY_COUNT]; // Double buffered display frame
 
 // Integral variables
 uint8_t         g_encoder_timeout = 0;
 uint8_t         g_song_entries = 0;
+volatile uint8_t g_frame_front = 0; // Frame buffer read by display interrupt
+volatile uint8_t g_interrupt_speed = INTERRUPT_SLOW;
+volatile uint8_t g_led_tick = 0; // Milliseconds since last LED frame
 
 //---------------------------------------------------------------------
 // Functions
@@ -122,6 +128,8 @@ void loop(void)
         g_config.music_timer = 0; SetConfig(g_config);
     }
     
+    MusicCacheSong(g_config.music_timer); // Start from cached directory
+    
     // Ensure alarm music setting is valid
     for (uint8_t index = 0; index < ALARM_COUNT; index++)
     {
@@ -130,13 +138,29 @@ void loop(void)
             g_config.alarm[index].music = 0;
             SetConfig(g_config);
         }
+        
+        MusicCacheSong(g_config.alarm[index].music);
     }
     
     while (true)
     {
+        // Loop body up to idle delay - blocking effects and menus are
+        // excluded as they exceed the range of the profile timestamp
+        PROFILE_BEGIN(loop);
+        LEDSchedule();
         AutoBrightness();
         previous_second = rtc.second;
-        g_rtc.GetRTC(rtc);
+        
+        // Refresh time unless an audio read is imminent - retried next loop
+        if (BusRequest(BUS_PRIORITY_RTC))
+        {
+            BusPending(BUS_PRIORITY_RTC, false);
+            g_rtc.GetRTC(rtc);
+        }
+        else
+        {
+            BusPending(BUS_PRIORITY_RTC, true); // Hold off frames until refreshed
+        }
         
         if (rtc.second != previous_second)
         {
@@ -156,6 +180,7 @@ void loop(void)
                     g_rtc.GetRTC(rtc); // Refresh RTC
                     FormatRTCString(rtc, s, RTCSelect::TIME);
                     g_display.EffectScroll(s, CDisplay::Direction::LEFT, 50);
+                    PROFILE_RESTART(loop);
                     break;
                 }
                 [[gnu::fallthrough]]; // Fall-through
@@ -177,6 +202,7 @@ void loop(void)
                     g_display.SetDisplayIndicator(false);
                     g_display.EffectSlotMachine(20);
                     delay(3050);
+                    PROFILE_RESTART(loop);
                     break;
                 }
                 [[gnu::fallthrough]]; // Fall-through
@@ -225,6 +251,7 @@ void loop(void)
 
                     g_state.menu = State::DISABLE;
                     UpdateAlarmIndicator();
+                    PROFILE_RESTART(loop);
                 }
             }
             
@@ -243,6 +270,7 @@ void loop(void)
             g_encoder_timeout--;
         }
         
+        PROFILE_END(loop, PROFILE_LOOP);
         delay(50); // Idle
     }
 }
@@ -674,14 +702,18 @@ void GetConfig(Config& config)
     cli();
     eeprom_read_block((void*)&config, (void*)0, sizeof(Config));
     sei();
+    config.led_effect = LEDEffectFromId(config.led_effect); // Saved as id
 }
 
 
 void SetConfig(const Config& config)
 {
+    Config saved = config;
+    saved.led_effect = LEDEffectGetId(config.led_effect); // Menu order may change
+    
     while (!eeprom_is_ready());
     cli();
-    eeprom_update_block((const void*)&config, (void*)0, sizeof(Config));
+    eeprom_update_block((const void*)&saved, (void*)0, sizeof(Config));
     sei();
 }
 
@@ -711,9 +743,48 @@ void DisplayState(State state)
 }
 
 
+void DisplayRender(void)
+{
+    const TubeFrame* front = g_frame[g_frame_front];
+    TubeFrame* frame = g_frame[g_frame_front ^ 1];
+    
+    for (uint8_t tube = 0; tube < DISPLAY_COUNT; tube++)
+    {
+        uint8_t unit = g_display.GetUnitValue(tube);
+        uint8_t indicator = g_display.GetUnitIndicator(tube);
+        uint8_t digit_bitmap = (pgm_read_byte_near(BITMAP + unit - 32) | (indicator << 2));
+        uint8_t duty = pgm_read_byte_near(BCM_DUTY + getValue(g_display.GetUnitBrightness(tube)));
+        
+        // Grid is only enabled when the tube has something to show
+        frame[tube].pattern = (digit_bitmap) ? ((_BV(tube) << 8) | digit_bitmap) : 0;
+        
+        // Ramp one level per render to smooth brightness transitions
+        frame[tube].duty = front[tube].duty;
+        
+        if (frame[tube].duty < duty)
+        {
+            frame[tube].duty++;
+        }
+        else if (frame[tube].duty > duty)
+        {
+            frame[tube].duty--;
+        }
+    }
+
+    // Publish frame only if content changed - single byte write is atomic
+    if (memcmp(frame, g_frame[g_frame_front], sizeof(g_frame[0])))
+    {
+        g_frame_front ^= 1;
+    }
+}
+
+
 void InterruptSpeed(const uint8_t speed)
 {
+    g_interrupt_speed = speed;
+    
     // set compare match register for xHz increments
+    // Display interrupt reprograms per bit-plane when fast
     OCR2A = speed; // = (16MHz) / (x*prescale) - 1 (must be <255)
 }
 
@@ -737,58 +808,67 @@ bool IsInputIncrement(void)
 
 bool IsInputSelect(void)
 {
+    LEDSchedule(); // Polled by blocking prompts
     return (g_encoder.GetButtonState() == CNcoder::Button::DOWN);
 }
 
 
 bool IsInputUpdate(void)
 {
+    LEDSchedule(); // Polled by blocking prompts
     return (g_encoder.IsUpdateAvailable());
 }
 
 
+// Called by delay() while waiting
+void yield(void)
+{
+    LEDSchedule();
+}
+
+
 // Interrupt is called every millisecond
 ISR(TIMER0_COMPA_vect) 
 {
-    static volatile bool active = false;
-
-    // Prevent interrupt from preempting itself
-    if (!active)
+    static volatile bool rendering = false;
+    
+    PROFILE_BEGIN(tick);
+    
+    // If I2C is blocked for more than 1s, reset
+    if (!nI2C->IsCommActive())
     {
-        active = true;
-        
-        // Don't process LEDs if update is not possible
-        if (!nI2C->IsCommActive())
-        {
-            // If I2C is blocked for more than 1s, reset
-            wdt_reset(); // Reset watchdog timer
-            sei(); // Re-enable interrupts
-
-            if (g_state.leds == State::ENABLE)
-            {
-                static uint8_t count = 0;
-                
-                // Update LEDs at 60Hz (~ 1/16ms)
-                if (++count == 16)
-                {
-                    count = 0;
-                    LEDProcess(g_config.led_effect);
-                    g_led_controller.Update(); // Update LEDs
-                }
-            }
-        }
-        
-        active = false;
+        wdt_reset(); // Reset watchdog timer
     }
+    
+    // LED frames are rendered by LEDSchedule() in main context
+    if (g_led_tick < UINT8_MAX)
+    {
+        g_led_tick++;
+    }
+    
+    // Render with interrupts enabled so the display interrupt is not held
+    // off - a tick arriving mid-render leaves the frame to the running one
+    if (!rendering)
+    {
+        rendering = true;
+        sei();
+        DisplayRender(); // Refresh display frame
+        cli();
+        rendering = false;
+    }
+    
+    PROFILE_END(tick, PROFILE_ISR_TICK);
 }
 
 
+// Binary code modulation - each tube is shown once per bit-plane for a
+// period proportional to the weight of the plane (LSB = INTERRUPT_FAST)
+// Pattern for the next period is shifted in while the current tube is lit
 ISR(TIMER2_COMPA_vect)
 {
-    uint8_t digit_bitmap = 0;
-    static uint8_t pwm_cycle = 0;
+    static uint8_t plane = 0;
     static uint8_t tube = 0;
-    static const uint16_t toggle[] = {0xFFF, 0x001, 0x041, 0x111, 0x249, 0x555, 0x5AD, 0x777, 0xFFF};
+    static uint8_t period = INTERRUPT_FAST; // Period of shifted pattern
     
     // No need to update display if disabled
     if (g_state.display == State::DISABLE)
@@ -796,75 +876,52 @@ ISR(TIMER2_COMPA_vect)
         return;
     }
 
-    setPinHigh(DIGITAL_PIN_BLANK); // blank display
+    PROFILE_BEGIN(display);
+
+    if (g_interrupt_speed == INTERRUPT_FAST)
+    {
+        // Set period of latched pattern
+        OCR2A = period - 1;
+    }
+
+    CVFD::Latch(); // Display pattern shifted during previous interrupt
     
     tube++;
 
     if (tube >= DISPLAY_COUNT)
     {
-        // change cycle after all tubes have cycled
-        pwm_cycle++;
+        // change bit-plane after all tubes have cycled
+        plane++;
 
-        if (pwm_cycle > 11)
+        if (plane >= BCM_PLANES)
         {
-            pwm_cycle = 0;
+            plane = 0;
         }
         
         tube = 0;
     }
 
-    if ((toggle[getValue(g_display.GetUnitBrightness(tube))] >> pwm_cycle) & 0x1)
-    {
-        uint8_t unit = g_display.GetUnitValue(tube);
-        uint8_t indicator = g_display.GetUnitIndicator(tube);
-        digit_bitmap = (pgm_read_byte_near(BITMAP + unit - 32) | (indicator << 2));
-    }
+    uint8_t weight = _BV(plane);
+    period = (INTERRUPT_FAST * weight);
 
-    setPinLow(DIGITAL_PIN_LATCH); // latch
+    const TubeFrame& frame = g_frame[g_frame_front][tube];
+    bool lit;
 
-    // Toggle tube grid
-    for (uint8_t index = DISPLAY_COUNT - 1; index < 255; index--)
+    if (g_interrupt_speed == INTERRUPT_FAST)
     {
-        setPinLow(DIGITAL_PIN_CLOCK); // clock
-
-        if (digit_bitmap && (index == tube))
-        {
-            setPinHigh(DIGITAL_PIN_SDATA); // sdata
-        }
-        else
-        {
-            setPinLow(DIGITAL_PIN_SDATA); // sdata
-        }
-
-        asm volatile("nop");
-        setPinHigh(DIGITAL_PIN_CLOCK); // clock
-        asm volatile("nop");
+        lit = (frame.duty & weight);
     }
-
-    // Toggle tube anodes
-    for (uint8_t index = 0; index < 8; index++)
+    else
     {
-        setPinLow(DIGITAL_PIN_CLOCK); // clock
-
-        if ((digit_bitmap >> (7 - index)) & 0x1)
-        {
-            setPinHigh(DIGITAL_PIN_SDATA); // sdata
-        }
-        else
-        {
-            setPinLow(DIGITAL_PIN_SDATA); // sdata
-        }
-
-        asm volatile("nop");
-        setPinHigh(DIGITAL_PIN_CLOCK); // clock
-        asm volatile("nop");
+        // Planes are equal length at slow speed - dim by lit plane count
+        lit = (frame.duty > ((plane * BCM_DUTY_MAX) / BCM_PLANES));
     }
 
-    asm volatile("nop");
-    asm volatile("nop");
-    
-    setPinHigh(DIGITAL_PIN_LATCH); // latch
-    setPinLow(DIGITAL_PIN_BLANK); // unblank display
+    uint16_t pattern = lit ? frame.pattern : 0;
+
+    // Shift next tube grid and anodes - latch holds current outputs
+    CVFD::Shift<TUBE_PATTERN_BITS>(pattern);
+    PROFILE_END(display, PROFILE_ISR_DISPLAY);
 }
 
 
@@ -895,4 +952,8 @@ void setup(void)
     TCCR2A |= _BV(WGM21); // Enable CTC mode
     TCCR2B |= _BV(CS22) | _BV(CS20); // Set CS22 bit for 128 prescaler
     TIMSK2 |= _BV(OCIE2A); // Enable timer compare interrupt
+
+#ifdef PROFILE
+    ProfileInitialize(); // Paint stack (Profiler shares Timer0)
+#endif
 }
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2026 PhotonicFusion LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Profile.cpp
+ * @summary     Interrupt and task cycle profiler for PhotoniClock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include "Profile.h"
+#include "Bus.h"
+
+#ifdef PROFILE_SERIAL
+#include <Arduino.h> // Serial
+#endif
+
+#ifdef PROFILE
+#pragma message "Compiling with profiler"
+
+// Each slot is only written from a single context
+static ProfileStruct g_profile[PROFILE_COUNT];
+
+// Free SRAM between static data and stack is painted at start-up - the
+// bytes still painted show how close the deepest stack came to the data
+extern uint8_t __heap_start; // End of static data (avr-libc)
+extern void* __brkval; // Heap top - null while malloc is unused
+static const uint8_t STACK_PAINT = 0xC5;
+static const uint8_t STACK_GUARD = 32; // Bytes left below caller frame
+
+
+static inline uint8_t* ProfileStackBottom(void) __attribute__((always_inline));
+static inline uint8_t* ProfileStackBottom(void)
+{
+    return (__brkval != nullptr) ? reinterpret_cast<uint8_t*>(__brkval) : &__heap_start;
+}
+
+
+void ProfileInitialize(void)
+{
+    uint8_t* top = reinterpret_cast<uint8_t*>(SP) - STACK_GUARD;
+    
+    for (uint8_t* p = ProfileStackBottom(); p < top; p++)
+    {
+        *p = STACK_PAINT;
+    }
+
+    // Timestamps come from Timer0 as configured by the Arduino core
+
+#ifdef PROFILE_SERIAL
+    Serial.begin(115200);
+#endif
+}
+
+
+void ProfileReset(void)
+{
+    cli();
+    
+    for (uint8_t slot = 0; slot < PROFILE_COUNT; slot++)
+    {
+        g_profile[slot] = ProfileStruct();
+    }
+    
+    sei();
+}
+
+
+void ProfileRecord(const uint8_t slot, const uint16_t ticks)
+{
+    if (slot >= PROFILE_COUNT)
+    {
+        return; // Invalid effect setting
+    }
+    
+    ProfileStruct& profile = g_profile[slot];
+    uint16_t budget = (slot == PROFILE_ISR_DISPLAY) ? BUDGET_DISPLAY : BUDGET_TASK;
+    
+    if (ticks < profile.min)
+    {
+        profile.min = ticks;
+    }
+    
+    if (ticks > profile.max)
+    {
+        profile.max = ticks;
+    }
+
+    if ((ticks > budget) && (profile.overrun < UINT16_MAX))
+    {
+        profile.overrun++;
+    }
+    
+    profile.avg = (((uint32_t)profile.avg * 7) + ticks) >> 3;
+}
+
+
+// Lowest free SRAM seen since start-up
+uint16_t ProfileGetStackFree(void)
+{
+    const uint8_t* p = ProfileStackBottom();
+    uint16_t count = 0;
+    
+    while ((p <= reinterpret_cast<const uint8_t*>(RAMEND)) && (*p++ == STACK_PAINT))
+    {
+        count++;
+    }
+    
+    return count;
+}
+
+
+uint16_t ProfileGetValue(const uint8_t slot, const uint8_t field)
+{
+    uint16_t value;
+    
+    cli(); // Slot may be updated from interrupt
+    
+    switch (field)
+    {
+    default:
+    case PROFILE_FIELD_MIN:
+        value = (g_profile[slot].min == UINT16_MAX) ? 0 : g_profile[slot].min;
+        break;
+    case PROFILE_FIELD_AVG:
+        value = g_profile[slot].avg;
+        break;
+    case PROFILE_FIELD_MAX:
+        value = g_profile[slot].max;
+        break;
+    case PROFILE_FIELD_OVERRUN:
+        sei();
+        return g_profile[slot].overrun; // Count - not converted
+    }
+    
+    sei();
+    return (value > (UINT16_MAX / US_PER_TICK)) ? UINT16_MAX : (value * US_PER_TICK);
+}
+
+
+void ProfileDump(void)
+{
+#ifdef PROFILE_SERIAL
+    Serial.println(F("slot,min_us,avg_us,max_us,overrun"));
+    
+    for (uint8_t slot = 0; slot < PROFILE_COUNT; slot++)
+    {
+        Serial.print(slot);
+        
+        for (uint8_t field = 0; field < PROFILE_FIELD_COUNT; field++)
+        {
+            Serial.print(',');
+            Serial.print(ProfileGetValue(slot, field));
+        }
+        
+        Serial.println();
+    }
+    
+    Serial.print(F("stack_free,"));
+    Serial.println(ProfileGetStackFree());
+    
+    Serial.print(F("led_frames,"));
+    Serial.print(LEDGetFrameCount());
+    Serial.print(F(",led_skipped,"));
+    Serial.println(LEDGetSkipCount());
+    
+    Serial.print(F("note_events,"));
+    Serial.print(NoteEventGetCount());
+    Serial.print(F(",note_dropped,"));
+    Serial.print(NoteEventGetDropCount());
+    Serial.print(F(",note_latency_ms,"));
+    Serial.println(NoteEventGetLatency());
+    
+    Serial.print(F("music_underrun,"));
+    Serial.print(MusicGetUnderrunCount());
+    Serial.print(F(",music_late,"));
+    Serial.println(MusicGetLateCount());
+    
+    Serial.println(F("bus,queued,dropped,late"));
+    
+    for (uint8_t priority = 0; priority < BUS_PRIORITY_COUNT; priority++)
+    {
+        Serial.print(priority);
+        
+        for (uint8_t counter = 0; counter < BUS_COUNTER_COUNT; counter++)
+        {
+            Serial.print(',');
+            Serial.print(BusGetCount(priority, counter));
+        }
+        
+        Serial.println();
+    }
+#endif
+}
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 PhotonicFusion LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Profile.h
+ * @summary     Interrupt and task cycle profiler for PhotoniClock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _PROFILE_H
+#define _PROFILE_H
+
+#include "LEDEffect.h"
+
+// Compile with PROFILE to enable (Timer0 and millis() overflow count as timestamp)
+// Compile with PROFILE_SERIAL to additionally dump results over Serial
+#ifdef PROFILE
+#define PROFILE_BEGIN(name)     uint16_t profile_##name = ProfileTimestamp()
+#define PROFILE_RESTART(name)   profile_##name = ProfileTimestamp() // Exclude blocking section
+#define PROFILE_END(name, slot) ProfileRecord(slot, ProfileTimestamp() - profile_##name)
+#else
+#define PROFILE_BEGIN(name)
+#define PROFILE_RESTART(name)
+#define PROFILE_END(name, slot)
+#endif
+
+enum PROFILE_SLOT : uint8_t
+{
+    PROFILE_ISR_DISPLAY,
+    PROFILE_ISR_TICK,
+    PROFILE_LOOP,
+    PROFILE_NOTE_TAP,
+    PROFILE_MUSIC_START, // PlayMusic to first byte served
+    PROFILE_EFFECT, // One entry per LED effect - must be last
+    PROFILE_COUNT = (PROFILE_EFFECT + LED_EFFECT_COUNT),
+};
+
+enum PROFILE_FIELD : uint8_t
+{
+    PROFILE_FIELD_MIN,
+    PROFILE_FIELD_AVG,
+    PROFILE_FIELD_MAX,
+    PROFILE_FIELD_OVERRUN,
+    PROFILE_FIELD_COUNT,
+};
+
+enum ProfileTiming : uint16_t
+{
+    US_PER_TICK     = 4,    // 16MHz / 64 prescale (Arduino Timer0)
+    BUDGET_DISPLAY  = (32 / US_PER_TICK),       // Shortest BCM period
+    BUDGET_TASK     = (1000 / US_PER_TICK),     // Millisecond tick
+};
+
+struct ProfileStruct
+{
+    uint16_t min = UINT16_MAX;
+    uint16_t avg = 0; // Moving average (1/8 weight)
+    uint16_t max = 0;
+    uint16_t overrun = 0;
+};
+
+void ProfileInitialize(void);
+void ProfileReset(void);
+void ProfileRecord(const uint8_t slot, const uint16_t ticks);
+uint16_t ProfileGetValue(const uint8_t slot, const uint8_t field);
+uint16_t ProfileGetStackFree(void);
+void ProfileDump(void);
+
+extern volatile unsigned long timer0_overflow_count; // Arduino core (wiring.c)
+
+// Timer0 count extended by the millis() overflow count - safe from any context
+// Timer1 is left to CAudio - spans wrap after 262ms
+static inline uint16_t ProfileTimestamp(void) __attribute__((always_inline));
+static inline uint16_t ProfileTimestamp(void)
+{
+    uint8_t sreg = SREG;
+    cli(); // Overflow count is updated from interrupt
+    uint8_t count = TCNT0;
+    uint8_t overflow = timer0_overflow_count;
+    
+    if ((TIFR0 & _BV(TOV0)) && (count < 255))
+    {
+        overflow++; // Overflow pending while interrupts are off - as micros()
+    }
+    
+    SREG = sreg;
+    return (((uint16_t)overflow << 8) | count);
+}
+
+#endif
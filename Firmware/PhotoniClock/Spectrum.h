@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 PhotonicFusion LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Spectrum.h
+ * @summary     Full saturation hue to RGB table
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _SPECTRUM_H
+#define _SPECTRUM_H
+
+#include <avr/pgmspace.h>
+
+/* === Spectrum Table ===
+
+ Channel ramps of hsv2rgb_spectrum() at saturation 255, indexed by hue
+ Entries are 4x the 6-bit ramp of hsv2rgb_raw_C(), so scaling by value
+ reproduces its (ramp * value) / 64 for every hue and value:
+
+   rgb[channel] = (SPECTRUM[hue][channel] * value) >> 8
+
+ EffectBench checks all 65536 pairs against its model of the C path
+
+=============================*/
+
+static const uint8_t SPECTRUM[256][3] PROGMEM =
+{
+    {0xFC, 0x00, 0x00}, {0xFC, 0x00, 0x00}, {0xF8, 0x04, 0x00}, {0xF4, 0x08, 0x00}, //   0
+    {0xF0, 0x0C, 0x00}, {0xF0, 0x0C, 0x00}, {0xEC, 0x10, 0x00}, {0xE8, 0x14, 0x00}, //   4
+    {0xE4, 0x18, 0x00}, {0xE4, 0x18, 0x00}, {0xE0, 0x1C, 0x00}, {0xDC, 0x20, 0x00}, //   8
+    {0xD8, 0x24, 0x00}, {0xD8, 0x24, 0x00}, {0xD4, 0x28, 0x00}, {0xD0, 0x2C, 0x00}, //  12
+    {0xCC, 0x30, 0x00}, {0xCC, 0x30, 0x00}, {0xC8, 0x34, 0x00}, {0xC4, 0x38, 0x00}, //  16
+    {0xC0, 0x3C, 0x00}, {0xC0, 0x3C, 0x00}, {0xBC, 0x40, 0x00}, {0xB8, 0x44, 0x00}, //  20
+    {0xB4, 0x48, 0x00}, {0xB4, 0x48, 0x00}, {0xB0, 0x4C, 0x00}, {0xAC, 0x50, 0x00}, //  24
+    {0xA8, 0x54, 0x00}, {0xA8, 0x54, 0x00}, {0xA4, 0x58, 0x00}, {0xA0, 0x5C, 0x00}, //  28
+    {0x9C, 0x60, 0x00}, {0x9C, 0x60, 0x00}, {0x98, 0x64, 0x00}, {0x94, 0x68, 0x00}, //  32
+    {0x90, 0x6C, 0x00}, {0x90, 0x6C, 0x00}, {0x8C, 0x70, 0x00}, {0x88, 0x74, 0x00}, //  36
+    {0x84, 0x78, 0x00}, {0x84, 0x78, 0x00}, {0x80, 0x7C, 0x00}, {0x7C, 0x80, 0x00}, //  40
+    {0x78, 0x84, 0x00}, {0x78, 0x84, 0x00}, {0x74, 0x88, 0x00}, {0x70, 0x8C, 0x00}, //  44
+    {0x6C, 0x90, 0x00}, {0x6C, 0x90, 0x00}, {0x68, 0x94, 0x00}, {0x64, 0x98, 0x00}, //  48
+    {0x60, 0x9C, 0x00}, {0x60, 0x9C, 0x00}, {0x5C, 0xA0, 0x00}, {0x58, 0xA4, 0x00}, //  52
+    {0x54, 0xA8, 0x00}, {0x54, 0xA8, 0x00}, {0x50, 0xAC, 0x00}, {0x4C, 0xB0, 0x00}, //  56
+    {0x48, 0xB4, 0x00}, {0x48, 0xB4, 0x00}, {0x44, 0xB8, 0x00}, {0x40, 0xBC, 0x00}, //  60
+    {0x3C, 0xC0, 0x00}, {0x3C, 0xC0, 0x00}, {0x38, 0xC4, 0x00}, {0x34, 0xC8, 0x00}, //  64
+    {0x30, 0xCC, 0x00}, {0x30, 0xCC, 0x00}, {0x2C, 0xD0, 0x00}, {0x28, 0xD4, 0x00}, //  68
+    {0x24, 0xD8, 0x00}, {0x24, 0xD8, 0x00}, {0x20, 0xDC, 0x00}, {0x1C, 0xE0, 0x00}, //  72
+    {0x18, 0xE4, 0x00}, {0x18, 0xE4, 0x00}, {0x14, 0xE8, 0x00}, {0x10, 0xEC, 0x00}, //  76
+    {0x0C, 0xF0, 0x00}, {0x0C, 0xF0, 0x00}, {0x08, 0xF4, 0x00}, {0x04, 0xF8, 0x00}, //  80
+    {0x00, 0xFC, 0x00}, {0x00, 0xFC, 0x00}, {0x00, 0xFC, 0x00}, {0x00, 0xF8, 0x04}, //  84
+    {0x00, 0xF4, 0x08}, {0x00, 0xF4, 0x08}, {0x00, 0xF0, 0x0C}, {0x00, 0xEC, 0x10}, //  88
+    {0x00, 0xE8, 0x14}, {0x00, 0xE8, 0x14}, {0x00, 0xE4, 0x18}, {0x00, 0xE0, 0x1C}, //  92
+    {0x00, 0xDC, 0x20}, {0x00, 0xDC, 0x20}, {0x00, 0xD8, 0x24}, {0x00, 0xD4, 0x28}, //  96
+    {0x00, 0xD0, 0x2C}, {0x00, 0xD0, 0x2C}, {0x00, 0xCC, 0x30}, {0x00, 0xC8, 0x34}, // 100
+    {0x00, 0xC4, 0x38}, {0x00, 0xC4, 0x38}, {0x00, 0xC0, 0x3C}, {0x00, 0xBC, 0x40}, // 104
+    {0x00, 0xB8, 0x44}, {0x00, 0xB8, 0x44}, {0x00, 0xB4, 0x48}, {0x00, 0xB0, 0x4C}, // 108
+    {0x00, 0xAC, 0x50}, {0x00, 0xAC, 0x50}, {0x00, 0xA8, 0x54}, {0x00, 0xA4, 0x58}, // 112
+    {0x00, 0xA0, 0x5C}, {0x00, 0xA0, 0x5C}, {0x00, 0x9C, 0x60}, {0x00, 0x98, 0x64}, // 116
+    {0x00, 0x94, 0x68}, {0x00, 0x94, 0x68}, {0x00, 0x90, 0x6C}, {0x00, 0x8C, 0x70}, // 120
+    {0x00, 0x88, 0x74}, {0x00, 0x88, 0x74}, {0x00, 0x84, 0x78}, {0x00, 0x80, 0x7C}, // 124
+    {0x00, 0x7C, 0x80}, {0x00, 0x7C, 0x80}, {0x00, 0x78, 0x84}, {0x00, 0x74, 0x88}, // 128
+    {0x00, 0x70, 0x8C}, {0x00, 0x70, 0x8C}, {0x00, 0x6C, 0x90}, {0x00, 0x68, 0x94}, // 132
+    {0x00, 0x64, 0x98}, {0x00, 0x64, 0x98}, {0x00, 0x60, 0x9C}, {0x00, 0x5C, 0xA0}, // 136
+    {0x00, 0x58, 0xA4}, {0x00, 0x58, 0xA4}, {0x00, 0x54, 0xA8}, {0x00, 0x50, 0xAC}, // 140
+    {0x00, 0x4C, 0xB0}, {0x00, 0x4C, 0xB0}, {0x00, 0x48, 0xB4}, {0x00, 0x44, 0xB8}, // 144
+    {0x00, 0x40, 0xBC}, {0x00, 0x40, 0xBC}, {0x00, 0x3C, 0xC0}, {0x00, 0x38, 0xC4}, // 148
+    {0x00, 0x34, 0xC8}, {0x00, 0x34, 0xC8}, {0x00, 0x30, 0xCC}, {0x00, 0x2C, 0xD0}, // 152
+    {0x00, 0x28, 0xD4}, {0x00, 0x28, 0xD4}, {0x00, 0x24, 0xD8}, {0x00, 0x20, 0xDC}, // 156
+    {0x00, 0x1C, 0xE0}, {0x00, 0x1C, 0xE0}, {0x00, 0x18, 0xE4}, {0x00, 0x14, 0xE8}, // 160
+    {0x00, 0x10, 0xEC}, {0x00, 0x10, 0xEC}, {0x00, 0x0C, 0xF0}, {0x00, 0x08, 0xF4}, // 164
+    {0x00, 0x04, 0xF8}, {0x00, 0x04, 0xF8}, {0x00, 0x00, 0xFC}, {0x00, 0x00, 0xFC}, // 168
+    {0x04, 0x00, 0xF8}, {0x04, 0x00, 0xF8}, {0x08, 0x00, 0xF4}, {0x0C, 0x00, 0xF0}, // 172
+    {0x10, 0x00, 0xEC}, {0x10, 0x00, 0xEC}, {0x14, 0x00, 0xE8}, {0x18, 0x00, 0xE4}, // 176
+    {0x1C, 0x00, 0xE0}, {0x1C, 0x00, 0xE0}, {0x20, 0x00, 0xDC}, {0x24, 0x00, 0xD8}, // 180
+    {0x28, 0x00, 0xD4}, {0x28, 0x00, 0xD4}, {0x2C, 0x00, 0xD0}, {0x30, 0x00, 0xCC}, // 184
+    {0x34, 0x00, 0xC8}, {0x34, 0x00, 0xC8}, {0x38, 0x00, 0xC4}, {0x3C, 0x00, 0xC0}, // 188
+    {0x40, 0x00, 0xBC}, {0x40, 0x00, 0xBC}, {0x44, 0x00, 0xB8}, {0x48, 0x00, 0xB4}, // 192
+    {0x4C, 0x00, 0xB0}, {0x4C, 0x00, 0xB0}, {0x50, 0x00, 0xAC}, {0x54, 0x00, 0xA8}, // 196
+    {0x58, 0x00, 0xA4}, {0x58, 0x00, 0xA4}, {0x5C, 0x00, 0xA0}, {0x60, 0x00, 0x9C}, // 200
+    {0x64, 0x00, 0x98}, {0x64, 0x00, 0x98}, {0x68, 0x00, 0x94}, {0x6C, 0x00, 0x90}, // 204
+    {0x70, 0x00, 0x8C}, {0x70, 0x00, 0x8C}, {0x74, 0x00, 0x88}, {0x78, 0x00, 0x84}, // 208
+    {0x7C, 0x00, 0x80}, {0x7C, 0x00, 0x80}, {0x80, 0x00, 0x7C}, {0x84, 0x00, 0x78}, // 212
+    {0x88, 0x00, 0x74}, {0x88, 0x00, 0x74}, {0x8C, 0x00, 0x70}, {0x90, 0x00, 0x6C}, // 216
+    {0x94, 0x00, 0x68}, {0x94, 0x00, 0x68}, {0x98, 0x00, 0x64}, {0x9C, 0x00, 0x60}, // 220
+    {0xA0, 0x00, 0x5C}, {0xA0, 0x00, 0x5C}, {0xA4, 0x00, 0x58}, {0xA8, 0x00, 0x54}, // 224
+    {0xAC, 0x00, 0x50}, {0xAC, 0x00, 0x50}, {0xB0, 0x00, 0x4C}, {0xB4, 0x00, 0x48}, // 228
+    {0xB8, 0x00, 0x44}, {0xB8, 0x00, 0x44}, {0xBC, 0x00, 0x40}, {0xC0, 0x00, 0x3C}, // 232
+    {0xC4, 0x00, 0x38}, {0xC4, 0x00, 0x38}, {0xC8, 0x00, 0x34}, {0xCC, 0x00, 0x30}, // 236
+    {0xD0, 0x00, 0x2C}, {0xD0, 0x00, 0x2C}, {0xD4, 0x00, 0x28}, {0xD8, 0x00, 0x24}, // 240
+    {0xDC, 0x00, 0x20}, {0xDC, 0x00, 0x20}, {0xE0, 0x00, 0x1C}, {0xE4, 0x00, 0x18}, // 244
+    {0xE8, 0x00, 0x14}, {0xE8, 0x00, 0x14}, {0xEC, 0x00, 0x10}, {0xF0, 0x00, 0x0C}, // 248
+    {0xF4, 0x00, 0x08}, {0xF4, 0x00, 0x08}, {0xF8, 0x00, 0x04}, {0xFC, 0x00, 0x00}, // 252
+};
+
+#endif
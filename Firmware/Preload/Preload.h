@@ -34,6 +34,7 @@
 #include <nDisplay.h>
 #include "LEDController.h"
 #include "crc8.h"
+#include "HV5812.h"
 
 const uint8_t       DISPLAY_COUNT = 6;
 const uint8_t       RETRY_LIMIT = 3;
@@ -95,6 +96,9 @@ enum digital_pin_t : uint8_t
     DIGITAL_PIN_TRANSDUCER_1 = A1,
 };
 
+// Display shift register chain
+typedef CHV5812<DIGITAL_PIN_CLOCK, DIGITAL_PIN_SDATA, DIGITAL_PIN_LATCH, DIGITAL_PIN_BLANK> CVFD;
+
 enum led_scale_t : uint8_t
 {
     LED_SCALE_R = 255,
@@ -536,7 +536,7 @@ void DisplayState(S s)
 
 ISR(TIMER2_COMPA_vect)
 {
-    uint8_t digit_bitmap = 0;
+    uint16_t pattern = 0;
     static uint8_t pwm_cycle = 0;
     static uint8_t tube = 0;
     static const uint16_t toggle[] = {0xFFF, 0x001, 0x041, 0x111, 0x249, 0x555, 0x5AD, 0x777, 0xFFF};
@@ -546,8 +546,6 @@ ISR(TIMER2_COMPA_vect)
     {
         return;
     }
-
-    setPinHigh(DIGITAL_PIN_BLANK); // blank display
     
     tube++;
 
@@ -568,55 +566,15 @@ ISR(TIMER2_COMPA_vect)
     {
         uint8_t unit = g_display.GetUnitValue(tube);
         uint8_t indicator = g_display.GetUnitIndicator(tube);
+        uint8_t digit_bitmap = (pgm_read_byte_near(BITMAP + unit - 32) | (indicator << 2));
     
-        digit_bitmap = (pgm_read_byte_near(BITMAP + unit - 32) | (indicator << 2));
-    }
-
-    setPinLow(DIGITAL_PIN_LATCH); // latch
-
-    // Toggle tube grid
-    for (uint8_t index = DISPLAY_COUNT - 1; index < 255; index--)
-    {
-        setPinLow(DIGITAL_PIN_CLOCK); // clock
-
-        if (digit_bitmap && (index == tube))
-        {
-            setPinHigh(DIGITAL_PIN_SDATA); // sdata
-        }
-        else
-        {
-            setPinLow(DIGITAL_PIN_SDATA); // sdata
-        }
-
-        asm volatile("nop");
-        setPinHigh(DIGITAL_PIN_CLOCK); // clock
-        asm volatile("nop");
+        // Grid is only enabled when the tube has something to show
+        pattern = (digit_bitmap) ? ((_BV(tube) << 8) | digit_bitmap) : 0;
     }
 
-    // Toggle tube anodes
-    for (uint8_t index = 0; index < 8; index++)
-    {
-        setPinLow(DIGITAL_PIN_CLOCK); // clock
-
-        if ((digit_bitmap >> (7 - index)) & 0x1)
-        {
-            setPinHigh(DIGITAL_PIN_SDATA); // sdata
-        }
-        else
-        {
-            setPinLow(DIGITAL_PIN_SDATA); // sdata
-        }
-
-        asm volatile("nop");
-        setPinHigh(DIGITAL_PIN_CLOCK); // clock
-        asm volatile("nop");
-    }
-
-    asm volatile("nop");
-    asm volatile("nop");
-    
-    setPinHigh(DIGITAL_PIN_LATCH); // latch
-    setPinLow(DIGITAL_PIN_BLANK); // unblank display
+    // Toggle tube grid and anodes
+    CVFD::Shift<DISPLAY_COUNT + 8>(pattern);
+    CVFD::Latch();
 }
 
 
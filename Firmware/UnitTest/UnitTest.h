@@ -34,6 +34,7 @@
 #include <nDisplay.h>
 #include <nI2C.h>
 #include "LEDController.h"
+#include "HV5812.h"
 
 const uint8_t       DISPLAY_COUNT = 6;
 const float         VOLTAGE_EXPECTED = 58.0;
@@ -89,6 +90,9 @@ enum digital_pin_t : uint8_t
     DIGITAL_PIN_TRANSDUCER_1 = A1,
 };
 
+// Display shift register chain
+typedef CHV5812<DIGITAL_PIN_CLOCK, DIGITAL_PIN_SDATA, DIGITAL_PIN_LATCH, DIGITAL_PIN_BLANK> CVFD;
+
 enum analog_pin_t : uint8_t
 {
     ANALOG_PIN_PHOTODIODE = A3,
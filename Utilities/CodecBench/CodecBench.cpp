@@ -0,0 +1,311 @@
+// CodecBench - host playback of packed EEPROM songs through the music stream
+//
+// Usage: codecbench <image> <expected>
+//
+// <image> is the EEPROM written by pack.py and <expected> the tokens of each
+// channel before packing. Every song is started with PlayMusic() and both
+// channels are read through the stream handed to CAudio - prefetch ring,
+// CNoteDecoder and loop interpreter as on the device - until END.
+//
+// Each song plays twice: with EEPROM reads completing before the next token,
+// then with reads held for READ_LATENCY tokens. Rests inserted on underrun
+// are dropped before comparing, so both passes must match exactly.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "Music.h"
+
+//---------------------------------------------------------------------
+// Firmware Globals
+//---------------------------------------------------------------------
+
+volatile uint8_t SREG;
+volatile uint8_t TCNT0;
+volatile uint8_t TIFR0;
+volatile unsigned long timer0_overflow_count;
+volatile uint8_t PORTB, PORTC, PORTD, DDRB, DDRC, DDRD;
+
+CAudio g_audio;
+CEEPROM g_eeprom;
+
+//---------------------------------------------------------------------
+// Simulation
+//---------------------------------------------------------------------
+
+static const uint32_t EEPROM_SIZE = 0x8000;
+static const uint8_t READ_QUEUE = 4; // Transactions held by nI2C
+static const uint8_t READ_LATENCY = 40; // Tokens per read in the slow pass - longer than a block lasts
+static const uint32_t TOKEN_LIMIT = 0x10000; // Stream offsets are 16-bit
+
+static uint8_t s_eeprom[EEPROM_SIZE];
+static uint32_t s_millis;
+static uint32_t s_latency;
+static uint32_t s_reads;
+
+static struct
+{
+    uint32_t address;
+    uint8_t* data;
+    uint32_t bytes;
+    void (*callback)(const uint8_t);
+    uint32_t due;
+} s_queue[READ_QUEUE];
+
+static uint8_t s_queued;
+
+static struct
+{
+    uint8_t (*stream)(uint16_t, void*);
+    void* data[Music::CHANNEL_COUNT];
+} s_audio;
+
+struct Channel
+{
+    std::string name;
+    std::vector<uint8_t> tokens;
+};
+
+
+unsigned long millis(void)
+{
+    return s_millis;
+}
+
+
+void delay(unsigned long ms)
+{
+    s_millis += ms;
+}
+
+
+void CAudio::Play(uint8_t (*stream)(uint16_t, void*), void* data_A, void* data_B)
+{
+    s_audio.stream = stream;
+    s_audio.data[0] = data_A;
+    s_audio.data[1] = data_B;
+}
+
+
+// Blocking without callback, otherwise queued until due as nI2C would
+uint8_t CEEPROM::Read(uint32_t address, uint8_t* data, uint32_t bytes, void (*callback)(const uint8_t))
+{
+    if ((address + bytes) > EEPROM_SIZE)
+    {
+        return 1;
+    }
+    
+    if (callback == nullptr)
+    {
+        memcpy(data, &s_eeprom[address], bytes);
+        return 0;
+    }
+    
+    if (s_queued == READ_QUEUE)
+    {
+        return 1; // Bus busy - caller retries
+    }
+    
+    s_queue[s_queued++] = {address, data, bytes, callback, s_millis + s_latency};
+    s_reads++;
+    return 0;
+}
+
+
+// Complete queued reads that are due - in order, one per step
+static void CompleteReads(void)
+{
+    if ((s_queued == 0) || (s_queue[0].due > s_millis))
+    {
+        return;
+    }
+    
+    auto read = s_queue[0];
+    memmove(&s_queue[0], &s_queue[1], (--s_queued) * sizeof(s_queue[0]));
+    memcpy(read.data, &s_eeprom[read.address], read.bytes);
+    read.callback(0);
+}
+
+
+static bool LoadImage(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    
+    if (file == nullptr)
+    {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+    
+    memset(s_eeprom, 0xFF, sizeof(s_eeprom)); // Erased
+    fread(s_eeprom, 1, sizeof(s_eeprom), file);
+    fclose(file);
+    return true;
+}
+
+
+// One line per channel: name, channel, tokens
+static bool LoadExpected(const char* path, std::vector<Channel>& channels)
+{
+    FILE* file = fopen(path, "r");
+    
+    if (file == nullptr)
+    {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+    
+    char name[128];
+    unsigned channel;
+    
+    while (fscanf(file, "%127s %u", name, &channel) == 2)
+    {
+        Channel entry;
+        entry.name = name;
+        unsigned token;
+        int next;
+        
+        while (((next = fgetc(file)) != '\n') && (next != EOF))
+        {
+            ungetc(next, file);
+            
+            if (fscanf(file, "%u", &token) == 1)
+            {
+                entry.tokens.push_back(token);
+            }
+        }
+        
+        channels.push_back(entry);
+    }
+    
+    fclose(file);
+    return ((channels.size() % Music::CHANNEL_COUNT) == 0);
+}
+
+
+// Returns false on first mismatch of either channel
+static bool PlaySong(const uint8_t song, const Channel* expected, const uint32_t latency, uint32_t& tokens, uint32_t& rests)
+{
+    s_latency = latency;
+    s_queued = 0;
+    PlayMusic(INBUILT_SONG_COUNT + song);
+    
+    uint16_t offset[Music::CHANNEL_COUNT] = {};
+    size_t played[Music::CHANNEL_COUNT] = {};
+    bool done[Music::CHANNEL_COUNT] = {};
+    bool match = true;
+    
+    for (uint32_t step = 0; !(done[0] && done[1]); step++)
+    {
+        s_millis++;
+        CompleteReads();
+        
+        for (uint8_t channel = 0; channel < Music::CHANNEL_COUNT; channel++)
+        {
+            if (done[channel])
+            {
+                continue;
+            }
+            
+            uint16_t underrun = MusicGetUnderrunCount();
+            uint8_t value = s_audio.stream(offset[channel]++, s_audio.data[channel]);
+            
+            if (MusicGetUnderrunCount() != underrun)
+            {
+                rests++; // Inserted in place of a late token
+                continue;
+            }
+            
+            const std::vector<uint8_t>& want = expected[channel].tokens;
+            size_t index = played[channel]++;
+            
+            if ((index >= want.size()) || (value != want[index]))
+            {
+                fprintf(stderr, "%s channel %u token %zu: expected %d got %u\n", expected[channel].name.c_str(),
+                    channel, index, (index < want.size()) ? want[index] : -1, value);
+                match = false;
+            }
+            
+            if (value == NOTE::END)
+            {
+                done[channel] = true;
+                tokens += played[channel];
+            }
+        }
+        
+        if (!match)
+        {
+            return false;
+        }
+        
+        if (step == TOKEN_LIMIT)
+        {
+            fprintf(stderr, "%s: no END after %u steps\n", expected[0].name.c_str(), step);
+            return false;
+        }
+    }
+    
+    for (uint8_t channel = 0; channel < Music::CHANNEL_COUNT; channel++)
+    {
+        if (played[channel] != expected[channel].tokens.size())
+        {
+            fprintf(stderr, "%s channel %u: END after %zu of %zu tokens\n", expected[channel].name.c_str(),
+                channel, played[channel], expected[channel].tokens.size());
+            match = false;
+        }
+    }
+    
+    return match;
+}
+
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: %s <image> <expected>\n", argv[0]);
+        return 2;
+    }
+    
+    std::vector<Channel> channels;
+    
+    if (!LoadImage(argv[1]) || !LoadExpected(argv[2], channels))
+    {
+        return 2;
+    }
+    
+    const uint8_t songs = (channels.size() / Music::CHANNEL_COUNT);
+    const uint32_t latency[] = {0, READ_LATENCY};
+    bool pass = true;
+    
+    printf("%-8s %6s %8s %8s %8s %8s\n", "latency", "songs", "tokens", "reads", "rests", "late");
+    
+    for (uint32_t hold : latency)
+    {
+        uint32_t tokens = 0;
+        uint32_t rests = 0;
+        uint32_t reads = s_reads;
+        uint16_t late = MusicGetLateCount();
+        uint8_t failed = 0;
+        
+        for (uint8_t song = 0; song < songs; song++)
+        {
+            failed += !PlaySong(song, &channels[song * Music::CHANNEL_COUNT], hold, tokens, rests);
+        }
+        
+        // Reads complete before they are needed without latency
+        if ((hold == 0) && (rests != 0))
+        {
+            fprintf(stderr, "%u rests inserted without read latency\n", rests);
+            failed++;
+        }
+        
+        printf("%-8u %6u %8u %8u %8u %8u   %s\n", hold, songs, tokens, s_reads - reads, rests,
+            (uint16_t)(MusicGetLateCount() - late), failed ? "FAIL" : "ok");
+        pass &= (failed == 0);
+    }
+    
+    return (pass ? 0 : 1);
+}
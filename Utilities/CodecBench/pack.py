@@ -0,0 +1,92 @@
+#!/usr/bin/python
+
+# Pack songs with notes2eeprom and write the image the device EEPROM would
+# hold, together with the tokens each channel must play back
+#
+# Usage: pack.py [-c] [-l] songs.json image.bin expected.txt
+
+from __future__ import print_function
+import sys
+import os
+import json
+import argparse
+
+__path__ = os.path.dirname(os.path.realpath(__file__))
+sys.path.insert(0, os.path.join(__path__, '..'))
+
+import notes2eeprom
+
+ADDRESS_START=0x100
+SIZE_MEMORY=0x8000
+SECTION_COUNT_SIZE=2 # Sent ahead of table - not written to EEPROM
+
+def main():
+    parser = argparse.ArgumentParser(description='Pack a JSON file as notes2eeprom does and write the resulting EEPROM image.')
+    parser.add_argument('file', metavar='file', type=str, help='a JSON file from midi2notes')
+    parser.add_argument('image', metavar='image', type=str, help='EEPROM image to write')
+    parser.add_argument('expected', metavar='expected', type=str, help='Channel tokens to write')
+    parser.add_argument('-c', '--compress', action='store_true', help='Store channels in compressed note stream format')
+    parser.add_argument('-l', '--loop', action='store_true', help='Replace repeated sections with loop opcodes')
+    args = parser.parse_args()
+
+    notes2eeprom.verbose = 0
+    notes2eeprom.crc_precompute_table()
+
+    with open(args.file) as file:
+        data = json.load(file)
+
+    # Keep per song progress of notes2eeprom out of the report
+    stdout = sys.stdout
+    sys.stdout = open(os.devnull, 'w')
+    try:
+        stream = notes2eeprom.process_data(data, ADDRESS_START, SIZE_MEMORY, args.compress, args.loop)
+    except SystemExit:
+        sys.stdout = stdout
+        notes2eeprom.error_msg_exit("notes2eeprom rejected " + args.file + " - run it directly for details")
+    sys.stdout = stdout
+
+    image = unframe(stream)
+
+    with open(args.image, 'wb') as file:
+        file.write(image)
+
+    with open(args.expected, 'w') as file:
+        for song in data:
+            channel = song['Channel_A']
+            for c in range(0, notes2eeprom.NUMBER_OF_CHANNELS):
+                # Missing channel shares offset of previous
+                channel = song.get('Channel_' + chr(c + ord('A')), channel)
+                file.write(song['Filename'] + ' ' + str(c) + ' ' + ' '.join(str(token) for token in channel) + '\n')
+
+    print("Packed", len(data), "songs to", len(image) - ADDRESS_START, "bytes")
+
+def unframe(stream):
+    """Recover EEPROM contents from sections as the device writes them"""
+    image = bytearray()
+    section = bytearray()
+    escape = False
+
+    for byte in stream:
+        if escape:
+            escape = False
+            section.append(byte)
+        elif byte == notes2eeprom.ESCAPE_INDICATOR:
+            escape = True
+        elif byte == notes2eeprom.SECTION_INDICATOR:
+            if not image:
+                section = section[SECTION_COUNT_SIZE:]
+            # Last byte of each section is CRC of the rest
+            if notes2eeprom.calc_crc(section[:-1]) != section[-1]:
+                notes2eeprom.error_msg_exit("CRC mismatch in section at EEPROM address " + str(len(image)))
+            image.extend(section[:-1])
+            section = bytearray()
+        else:
+            section.append(byte)
+
+    if section or escape:
+        notes2eeprom.error_msg_exit("Stream ends inside a section")
+
+    return image
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,355 @@
+// EffectBench - host run of every LED effect against golden PWM frames
+//
+// Usage: effectbench check|record [golden directory]
+//
+// Each effect runs from a zeroed state for RUN_TIME ms of simulated time with
+// a fixed random seed, clock and note script. LEDSchedule is not called for
+// STALL_TIME ms from STALL_START, as while the main loop blocks without
+// yield(), so the capped catch-up after a stall is covered. Every rendered
+// frame is written as the 18 PWM values seen by the driver, or "off" while it
+// is shut down.
+// "record" rewrites the golden files, "check" compares against them.
+//
+// Both modes fail an effect whose brightest frame stays below PEAK_MIN, so
+// an effect that went dark cannot be recorded as golden. Disable must stay off.
+// Both modes also fail if the Spectrum.h table path of CLED::HueToRGB differs
+// from hsv2rgb_spectrum for any hue and value.
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include "EffectBench.h"
+#include "LEDEffect.h"
+
+//---------------------------------------------------------------------
+// Firmware Globals
+//---------------------------------------------------------------------
+
+volatile uint8_t SREG;
+volatile uint8_t TCNT0;
+volatile uint8_t TIFR0;
+volatile unsigned long timer0_overflow_count;
+volatile uint8_t PORTB, PORTC, PORTD, DDRB, DDRC, DDRD;
+CI2C* nI2C = nullptr;
+
+volatile uint8_t g_led_tick;
+StateStruct g_state;
+Config g_config;
+CLED g_led_controller{LED_SCALE_R, LED_SCALE_G, LED_SCALE_B};
+uint8_t g_leds[CLED::COUNT::LED];
+CRTC::RTC* g_rtc_struct;
+
+//---------------------------------------------------------------------
+// Simulation
+//---------------------------------------------------------------------
+
+static const uint16_t RUN_TIME = 5000; // Simulated ms per effect - crosses a minute for Cycle
+static const uint16_t RANDOM_SEED = 1337; // FastLED default seed
+static const CRTC::RTC RTC_START = {18, 10, 17, 6, 12, 59, 58, false};
+static const uint8_t NOTE_INTERVAL = 125; // Visualizer note spacing (ms)
+static const uint8_t PEAK_MIN = 16; // Lowest acceptable peak PWM of a lit effect
+static const uint16_t STALL_START = 2000; // Main context blocked from (ms)
+static const uint16_t STALL_TIME = 200; // Longer than the tick counter holds
+
+static uint32_t s_millis;
+static CRTC::RTC s_rtc;
+
+static struct
+{
+    uint8_t pwm[CLED::COUNT::LED];
+    bool enabled;
+    uint32_t bytes;
+} s_driver;
+
+
+unsigned long millis(void)
+{
+    return s_millis;
+}
+
+
+void delay(unsigned long ms)
+{
+    s_millis += ms;
+}
+
+
+void BenchDriverWrite(const uint8_t pwm[], const bool enabled, const uint8_t bytes)
+{
+    memcpy(s_driver.pwm, pwm, sizeof(s_driver.pwm));
+    s_driver.enabled = enabled;
+    s_driver.bytes += bytes;
+}
+
+
+// Two channels of arpeggio - one note every NOTE_INTERVAL ms
+bool NoteEventRead(NoteEvent& event)
+{
+    static const uint8_t pitch[] = {NC4, NE4, NG4, NC5, NG4, NE4, NC4, NG3};
+    static const uint8_t duration[] = {DS, DE, DQ, DH};
+    static uint32_t next = 0;
+    
+    if (s_millis < next)
+    {
+        return false;
+    }
+    
+    uint8_t index = (s_millis / NOTE_INTERVAL);
+    next = ((uint32_t)(index + 1) * NOTE_INTERVAL);
+    event.pitch = pitch[index % sizeof(pitch)];
+    event.duration = duration[(index >> 1) % sizeof(duration)];
+    event.channel = (index & 0x1);
+    event.stamp = (uint8_t)s_millis;
+    return true;
+}
+
+
+static void AdvanceRTC(void)
+{
+    if (++s_rtc.second < 60)
+    {
+        return;
+    }
+    
+    s_rtc.second = 0;
+    
+    if (++s_rtc.minute < 60)
+    {
+        return;
+    }
+    
+    s_rtc.minute = 0;
+    s_rtc.hour = (s_rtc.hour % 12) + 1;
+}
+
+
+static std::string FrameLine(void)
+{
+    char line[8 + (2 * CLED::COUNT::LED)];
+    int length = snprintf(line, sizeof(line), "%05u ", (unsigned)s_millis);
+    
+    if (!s_driver.enabled)
+    {
+        snprintf(line + length, sizeof(line) - length, "off");
+        return line;
+    }
+    
+    for (uint8_t led = 0; led < CLED::COUNT::LED; led++)
+    {
+        length += snprintf(line + length, sizeof(line) - length, "%02x", s_driver.pwm[led]);
+    }
+    
+    return line;
+}
+
+
+// Menu item without padding, lower case - also the golden file name
+static std::string EffectName(const uint8_t effect)
+{
+    std::string name;
+    
+    for (const char* c = LEDEffectGetName(effect); *c != '\0'; c++)
+    {
+        if (*c != ' ')
+        {
+            name += tolower(*c);
+        }
+    }
+    
+    return name;
+}
+
+
+// Table lookup must equal the conversion it replaces for every input
+static bool CheckSpectrum(void)
+{
+    uint32_t mismatch = 0;
+    
+    for (uint16_t input = 0; input <= UINT16_MAX; input++)
+    {
+        CHSV hsv;
+        CRGB table;
+        CRGB model;
+        hsv.hue = (input >> 8);
+        hsv.saturation = 255;
+        hsv.value = (input & 0xFF);
+        CLED::HueToRGB(hsv, table);
+        hsv2rgb_spectrum(hsv, model);
+        
+        for (uint8_t channel = 0; channel < 3; channel++)
+        {
+            if (table[channel] != model[channel])
+            {
+                mismatch++;
+                break;
+            }
+        }
+        
+        if (input == UINT16_MAX)
+        {
+            break;
+        }
+    }
+    
+    if (mismatch)
+    {
+        fprintf(stderr, "spectrum: %u of 65536 hue/value pairs differ from hsv2rgb_spectrum\n", mismatch);
+    }
+    
+    return (mismatch == 0);
+}
+
+
+// Returns false on first mismatch against golden file
+static bool RunEffect(const uint8_t effect, const std::string& path, const bool record)
+{
+    const std::string name = EffectName(effect);
+    const std::string target = record ? (path + ".new") : path; // Renamed once sane
+    FILE* file = fopen(target.c_str(), record ? "w" : "r");
+    
+    if (file == nullptr)
+    {
+        fprintf(stderr, "%s: cannot open %s\n", name.c_str(), target.c_str());
+        return false;
+    }
+    
+    random16_set_seed(RANDOM_SEED);
+    s_millis = 0;
+    s_rtc = RTC_START;
+    s_driver.bytes = 0;
+    g_led_tick = 0;
+    g_config.led_effect = effect;
+    
+    uint16_t frame_start = LEDGetFrameCount();
+    uint32_t ops_start = g_bench_ops;
+    uint16_t line_number = 0;
+    uint8_t peak = 0;
+    bool match = true;
+    std::chrono::nanoseconds host_time(0);
+    
+    while (s_millis < RUN_TIME)
+    {
+        uint16_t frame = LEDGetFrameCount();
+        s_millis++;
+        
+        if (g_led_tick < UINT8_MAX)
+        {
+            g_led_tick++; // Saturates as in the tick interrupt
+        }
+        
+        if ((s_millis % 1000) == 0)
+        {
+            AdvanceRTC();
+        }
+        
+        if ((s_millis > STALL_START) && (s_millis <= (STALL_START + STALL_TIME)))
+        {
+            continue;
+        }
+        
+        auto begin = std::chrono::steady_clock::now();
+        LEDSchedule();
+        host_time += (std::chrono::steady_clock::now() - begin);
+        
+        if (LEDGetFrameCount() == frame)
+        {
+            continue;
+        }
+        
+        std::string line = FrameLine();
+        line_number++;
+        
+        for (uint8_t led = 0; s_driver.enabled && (led < CLED::COUNT::LED); led++)
+        {
+            peak = max(peak, s_driver.pwm[led]);
+        }
+        
+        if (record)
+        {
+            fprintf(file, "%s\n", line.c_str());
+        }
+        else if (match)
+        {
+            char expected[64] = "<eof>";
+            
+            if (fgets(expected, sizeof(expected), file) != nullptr)
+            {
+                expected[strcspn(expected, "\n")] = '\0';
+            }
+            
+            if (line != expected)
+            {
+                fprintf(stderr, "%s:%u: expected '%s' got '%s'\n", path.c_str(), line_number, expected, line.c_str());
+                match = false;
+            }
+        }
+    }
+    
+    char extra[64];
+    
+    if (!record && match && (fgets(extra, sizeof(extra), file) != nullptr))
+    {
+        fprintf(stderr, "%s:%u: golden file has more frames\n", path.c_str(), line_number + 1);
+        match = false;
+    }
+    
+    fclose(file);
+    
+    bool dark = (effect == LED_EFFECT_DISABLE);
+    bool sane = dark ? (peak == 0) : (peak >= PEAK_MIN);
+    
+    if (!sane)
+    {
+        fprintf(stderr, "%s: peak PWM %u, expected %s%u\n", name.c_str(), peak, dark ? "" : ">= ", dark ? 0 : PEAK_MIN);
+        match = false;
+    }
+    
+    if (record && !(match && (rename(target.c_str(), path.c_str()) == 0)))
+    {
+        remove(target.c_str()); // Previous golden is kept
+        match = false;
+    }
+    
+    uint16_t frames = LEDGetFrameCount() - frame_start;
+    uint32_t ops = g_bench_ops - ops_start;
+    printf("%-8s %6u %5u %10.1f %10.1f %10.0f   %s\n", name.c_str(), frames, peak,
+        frames ? ((double)ops / frames) : 0.0,
+        frames ? ((double)s_driver.bytes / frames) : 0.0,
+        frames ? ((double)host_time.count() / frames) : 0.0,
+        match ? (record ? "recorded" : "ok") : "FAIL");
+    
+    return match;
+}
+
+
+int main(int argc, char* argv[])
+{
+    if ((argc < 2) || (argc > 3) || (strcmp(argv[1], "check") && strcmp(argv[1], "record")))
+    {
+        fprintf(stderr, "usage: %s check|record [golden directory]\n", argv[0]);
+        return 2;
+    }
+    
+    const bool record = (strcmp(argv[1], "record") == 0);
+    const std::string directory = (argc == 3) ? argv[2] : "golden";
+    bool pass = true;
+    
+    g_rtc_struct = &s_rtc;
+    g_state.leds = State::ENABLE;
+    g_led_controller.Initialize();
+    g_led_controller.AssignLEDs(g_leds);
+    
+    pass &= CheckSpectrum();
+    
+    printf("%-8s %6s %5s %10s %10s %10s\n", "effect", "frames", "peak", "lib8/frame", "bus/frame", "host ns");
+    
+    for (uint8_t effect = 0; effect < LED_EFFECT_COUNT; effect++)
+    {
+        pass &= RunEffect(effect, directory + "/" + EffectName(effect) + ".txt", record);
+    }
+    
+    return (pass ? 0 : 1);
+}
@@ -0,0 +1,10 @@
+// Hooks between EffectBench and the mock LED driver
+#ifndef _EFFECTBENCH_H
+#define _EFFECTBENCH_H
+
+#include <stdint.h>
+
+// Called by the mock driver for every transaction the firmware would put on the bus
+void BenchDriverWrite(const uint8_t pwm[], const bool enabled, const uint8_t bytes);
+
+#endif
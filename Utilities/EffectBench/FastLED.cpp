@@ -0,0 +1,210 @@
+// Host implementation of the FastLED subset in stub/FastLED.h
+// Algorithms follow FastLED 3.x C paths so frames match the firmware
+
+#include "FastLED.h"
+
+uint32_t g_bench_ops = 0;
+
+static uint16_t rand16seed = 1337;
+
+
+uint8_t scale8(const uint8_t i, const fract8 scale)
+{
+    g_bench_ops++;
+    return (((uint16_t)i * (1 + (uint16_t)scale)) >> 8);
+}
+
+
+uint8_t qadd8(const uint8_t i, const uint8_t j)
+{
+    g_bench_ops++;
+    uint16_t t = i + j;
+    return (t > 255) ? 255 : t;
+}
+
+
+uint8_t qsub8(const uint8_t i, const uint8_t j)
+{
+    g_bench_ops++;
+    return (i > j) ? (i - j) : 0;
+}
+
+
+uint8_t blend8(const uint8_t a, const uint8_t b, const uint8_t amount_of_b)
+{
+    g_bench_ops++;
+    uint16_t partial = (a << 8) | b;
+    partial += (b * amount_of_b);
+    partial -= (a * amount_of_b);
+    return (partial >> 8);
+}
+
+
+uint8_t random8(void)
+{
+    g_bench_ops++;
+    rand16seed = (rand16seed * 2053) + 13849;
+    return (uint8_t)((uint8_t)(rand16seed & 0xFF) + (uint8_t)(rand16seed >> 8));
+}
+
+
+uint8_t random8(const uint8_t lim)
+{
+    uint8_t r = random8();
+    return ((r * lim) >> 8);
+}
+
+
+uint8_t random8(const uint8_t min, const uint8_t lim)
+{
+    uint8_t delta = lim - min;
+    return (random8(delta) + min);
+}
+
+
+uint16_t random16(void)
+{
+    g_bench_ops++;
+    rand16seed = (rand16seed * 2053) + 13849;
+    return rand16seed;
+}
+
+
+void random16_set_seed(const uint16_t seed)
+{
+    rand16seed = seed;
+}
+
+
+void* memset8(void* ptr, const uint8_t value, const uint16_t num)
+{
+    g_bench_ops++;
+    return memset(ptr, value, num);
+}
+
+
+void* memcpy8(void* dst, const void* src, const uint16_t num)
+{
+    g_bench_ops++;
+    return memcpy(dst, src, num);
+}
+
+
+void hsv2rgb_raw(const CHSV& hsv, CRGB& rgb)
+{
+    g_bench_ops++;
+    
+    const uint8_t HSV_SECTION_3 = 0x40;
+    uint8_t value = hsv.value;
+    uint8_t invsat = 255 - hsv.saturation;
+    uint8_t brightness_floor = (value * invsat) / 256;
+    uint8_t color_amplitude = value - brightness_floor;
+    uint8_t section = hsv.hue / HSV_SECTION_3;
+    uint8_t offset = hsv.hue % HSV_SECTION_3;
+    uint8_t rampup = offset;
+    uint8_t rampdown = (HSV_SECTION_3 - 1) - offset;
+    uint8_t rampup_adj = ((rampup * color_amplitude) / (256 / 4)) + brightness_floor;
+    uint8_t rampdown_adj = ((rampdown * color_amplitude) / (256 / 4)) + brightness_floor;
+    
+    if (section == 0)
+    {
+        rgb = CRGB(rampdown_adj, rampup_adj, brightness_floor);
+    }
+    else if (section == 1)
+    {
+        rgb = CRGB(brightness_floor, rampdown_adj, rampup_adj);
+    }
+    else
+    {
+        rgb = CRGB(rampup_adj, brightness_floor, rampdown_adj);
+    }
+}
+
+
+void hsv2rgb_spectrum(const CHSV& hsv, CRGB& rgb)
+{
+    CHSV hsv2 = hsv;
+    hsv2.hue = scale8(hsv2.hue, 191);
+    hsv2rgb_raw(hsv2, rgb);
+}
+
+
+void fill_gradient_RGB(CRGB* leds, uint16_t startpos, CRGB startcolor, uint16_t endpos, CRGB endcolor)
+{
+    g_bench_ops++;
+    
+    if (endpos < startpos)
+    {
+        uint16_t t = endpos;
+        CRGB tc = endcolor;
+        endcolor = startcolor;
+        endpos = startpos;
+        startpos = t;
+        startcolor = tc;
+    }
+    
+    int16_t divisor = (endpos - startpos) ? (endpos - startpos) : 1;
+    int16_t delta[3];
+    uint16_t accum[3];
+    
+    for (uint8_t channel = 0; channel < 3; channel++)
+    {
+        delta[channel] = (int16_t)(((endcolor[channel] - startcolor[channel]) << 7) / divisor) * 2;
+        accum[channel] = (startcolor[channel] << 8);
+    }
+    
+    for (uint16_t i = startpos; i <= endpos; i++)
+    {
+        leds[i] = CRGB(accum[0] >> 8, accum[1] >> 8, accum[2] >> 8);
+        
+        for (uint8_t channel = 0; channel < 3; channel++)
+        {
+            accum[channel] += delta[channel];
+        }
+    }
+}
+
+
+CRGBPalette16::CRGBPalette16(const CRGB& c1, const CRGB& c2, const CRGB& c3, const CRGB& c4)
+{
+    const uint16_t onethird = (16 / 3);
+    const uint16_t twothirds = ((16 * 2) / 3);
+    
+    fill_gradient_RGB(entries, 0, c1, onethird, c2);
+    fill_gradient_RGB(entries, onethird, c2, twothirds, c3);
+    fill_gradient_RGB(entries, twothirds, c3, 15, c4);
+}
+
+
+CRGB ColorFromPalette(const CRGBPalette16& pal, const uint8_t index, uint8_t brightness, const TBlendType blend_type)
+{
+    g_bench_ops++;
+    
+    uint8_t hi4 = (index >> 4);
+    uint8_t lo4 = (index & 0x0F);
+    CRGB color = pal[hi4];
+    
+    if (lo4 && (blend_type != NOBLEND))
+    {
+        const CRGB& next = pal[(hi4 == 15) ? 0 : (hi4 + 1)];
+        uint8_t f2 = (lo4 << 4);
+        uint8_t f1 = 255 - f2;
+        
+        for (uint8_t channel = 0; channel < 3; channel++)
+        {
+            color[channel] = scale8(color[channel], f1) + scale8(next[channel], f2);
+        }
+    }
+    
+    if (brightness != 255)
+    {
+        brightness++; // Adjust for rounding
+        
+        for (uint8_t channel = 0; channel < 3; channel++)
+        {
+            color[channel] = (brightness > 1) ? scale8(color[channel], brightness) : 0;
+        }
+    }
+    
+    return color;
+}
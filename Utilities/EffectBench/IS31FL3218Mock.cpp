@@ -0,0 +1,80 @@
+// Mock of CIS31FL3218 - replaces IS31FL3218.cpp for host builds
+// Keeps the register shadow and burst rules of Commit, reports bus bytes instead of writing
+
+#include "IS31FL3218.h"
+#include "EffectBench.h"
+
+
+CIS31FL3218::CIS31FL3218(void)
+{
+    reset();
+}
+
+
+void CIS31FL3218::Initialize(void)
+{
+    reset();
+    SetDeviceState(State::ENABLE);
+}
+
+
+CIS31FL3218::status_t CIS31FL3218::SetDeviceState(const State state)
+{
+    m_device_state = state;
+    BenchDriverWrite(m_register.pwm, (state == State::ENABLE), (I2C_OVERHEAD + 1));
+    return STATUS_OK;
+}
+
+
+CIS31FL3218::State CIS31FL3218::GetDeviceState(void)
+{
+    return m_device_state;
+}
+
+
+// Same burst length as the driver - first changed register through update
+CIS31FL3218::status_t CIS31FL3218::Commit(const uint8_t pwm_array[COUNT::LED], const State state_array[COUNT::LED])
+{
+    const uint8_t NONE = sizeof(RegisterStruct);
+    uint8_t first = NONE;
+    
+    (void)state_array; // Control registers are not exercised by effects
+    
+    for (uint8_t led = 0; led < COUNT::LED; led++)
+    {
+        if ((first == NONE) && (!m_shadow_valid || (pwm_array[led] != m_register.pwm[led])))
+        {
+            first = led;
+        }
+        
+        m_register.pwm[led] = pwm_array[led];
+    }
+    
+    if (first == NONE)
+    {
+        m_bytes_saved += (I2C_OVERHEAD + sizeof(RegisterStruct));
+        BenchDriverWrite(m_register.pwm, (m_device_state == State::ENABLE), 0);
+        return STATUS_OK; // Nothing to send
+    }
+    
+    m_shadow_valid = true;
+    m_bytes_saved += first;
+    BenchDriverWrite(m_register.pwm, (m_device_state == State::ENABLE), (I2C_OVERHEAD + sizeof(RegisterStruct) - first));
+    return STATUS_OK;
+}
+
+
+uint32_t CIS31FL3218::GetBytesSaved(void)
+{
+    return m_bytes_saved;
+}
+
+
+void CIS31FL3218::reset(void)
+{
+    memset(&m_register, 0, sizeof(m_register));
+    m_device_state = State::DISABLE;
+    m_shadow_valid = true; // Device reset clears registers
+    m_update_pending = false;
+    m_bytes_saved = 0;
+}
@@ -0,0 +1,28 @@
+// Host stand-in for the Arduino core - only what the LED modules use
+#ifndef _BENCH_ARDUINO_H
+#define _BENCH_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+
+unsigned long millis(void); // Simulated clock of EffectBench
+void delay(unsigned long ms);
+
+enum : uint8_t
+{
+    A0 = 14, A1, A2, A3, A4, A5, A6, A7,
+};
+
+#define min(a,b) ((a)<(b)?(a):(b))
+#define max(a,b) ((a)>(b)?(a):(b))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+
+#endif
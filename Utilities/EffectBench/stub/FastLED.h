@@ -0,0 +1,104 @@
+// Host stand-in for FastLED - 8-bit math as built for AVR (SCALE8_FIXED)
+// Every primitive adds to g_bench_ops so effects can be compared by work per frame
+#ifndef _BENCH_FASTLED_H
+#define _BENCH_FASTLED_H
+
+#include <Arduino.h> // As the real library does
+
+typedef uint8_t fract8;
+
+extern uint32_t g_bench_ops; // Primitive calls since last reset
+
+struct CRGB
+{
+    union
+    {
+        struct
+        {
+            uint8_t r;
+            uint8_t g;
+            uint8_t b;
+        };
+        uint8_t raw[3];
+    };
+    
+    enum HTMLColorCode : uint32_t
+    {
+        Black = 0x000000,
+    };
+    
+    CRGB(void) = default;
+    
+    constexpr CRGB(const uint8_t ir, const uint8_t ig, const uint8_t ib)
+        : r(ir), g(ig), b(ib)
+    {
+    }
+    
+    constexpr CRGB(const HTMLColorCode code)
+        : r((code >> 16) & 0xFF), g((code >> 8) & 0xFF), b(code & 0xFF)
+    {
+    }
+    
+    uint8_t& operator[](const uint8_t x)
+    {
+        return raw[x];
+    }
+    
+    const uint8_t& operator[](const uint8_t x) const
+    {
+        return raw[x];
+    }
+};
+
+struct CHSV
+{
+    union
+    {
+        struct
+        {
+            uint8_t hue;
+            uint8_t saturation;
+            uint8_t value;
+        };
+        uint8_t raw[3];
+    };
+};
+
+class CRGBPalette16
+{
+    public:
+    
+    CRGB entries[16];
+    
+    CRGBPalette16(void) = default;
+    CRGBPalette16(const CRGB& c1, const CRGB& c2, const CRGB& c3, const CRGB& c4);
+    
+    const CRGB& operator[](const uint8_t x) const
+    {
+        return entries[x];
+    }
+};
+
+enum TBlendType
+{
+    NOBLEND = 0,
+    LINEARBLEND = 1,
+};
+
+uint8_t scale8(const uint8_t i, const fract8 scale);
+uint8_t qadd8(const uint8_t i, const uint8_t j);
+uint8_t qsub8(const uint8_t i, const uint8_t j);
+uint8_t blend8(const uint8_t a, const uint8_t b, const uint8_t amount_of_b);
+uint8_t random8(void);
+uint8_t random8(const uint8_t lim);
+uint8_t random8(const uint8_t min, const uint8_t lim);
+uint16_t random16(void);
+void random16_set_seed(const uint16_t seed);
+void* memset8(void* ptr, const uint8_t value, const uint16_t num);
+void* memcpy8(void* dst, const void* src, const uint16_t num);
+void hsv2rgb_raw(const CHSV& hsv, CRGB& rgb);
+void hsv2rgb_spectrum(const CHSV& hsv, CRGB& rgb);
+void fill_gradient_RGB(CRGB* leds, uint16_t startpos, CRGB startcolor, uint16_t endpos, CRGB endcolor);
+CRGB ColorFromPalette(const CRGBPalette16& pal, const uint8_t index, uint8_t brightness = 255, const TBlendType blend_type = LINEARBLEND);
+
+#endif
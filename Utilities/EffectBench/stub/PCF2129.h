@@ -0,0 +1,24 @@
+// Host stand-in for PCF2129 - time is set by EffectBench
+#ifndef _BENCH_PCF2129_H
+#define _BENCH_PCF2129_H
+
+#include <stdint.h>
+
+class CRTC
+{
+    public:
+    
+    struct RTC
+    {
+        uint8_t year;
+        uint8_t month;
+        uint8_t day;
+        uint8_t week_day;
+        uint8_t hour;
+        uint8_t minute;
+        uint8_t second;
+        bool am;
+    };
+};
+
+#endif
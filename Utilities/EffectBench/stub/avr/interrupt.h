@@ -0,0 +1,8 @@
+// Host stand-in - single threaded, interrupts are never taken
+#ifndef _BENCH_AVR_INTERRUPT_H
+#define _BENCH_AVR_INTERRUPT_H
+
+#define cli()
+#define sei()
+
+#endif
@@ -0,0 +1,14 @@
+// Host stand-in - registers are plain variables
+#ifndef _BENCH_AVR_IO_H
+#define _BENCH_AVR_IO_H
+
+#include <stdint.h>
+
+extern volatile uint8_t SREG;
+extern volatile uint8_t TCNT0, TIFR0;
+extern volatile uint8_t PORTB, PORTC, PORTD, DDRB, DDRC, DDRD;
+
+#define _BV(bit) (1 << (bit))
+#define TOV0 0
+
+#endif
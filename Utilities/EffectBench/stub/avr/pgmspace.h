@@ -0,0 +1,17 @@
+// Host stand-in - program memory is ordinary memory
+#ifndef _BENCH_AVR_PGMSPACE_H
+#define _BENCH_AVR_PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P const char*
+#define PSTR(s) (s)
+#define pgm_read_byte(a) (*(const uint8_t*)(a))
+#define pgm_read_byte_near(a) (*(const uint8_t*)(a))
+#define pgm_read_word(a) (*(const uint16_t*)(a))
+#define pgm_read_ptr(a) (*(void* const*)(a))
+#define memcpy_P memcpy
+
+#endif
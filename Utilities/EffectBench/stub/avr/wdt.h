@@ -0,0 +1,4 @@
+// Host stand-in - declarations only
+#ifndef _BENCH_AVR_WDT_H
+#define _BENCH_AVR_WDT_H
+#endif
@@ -0,0 +1,32 @@
+// Host stand-in for nAudio - token values of the music format and stream hook
+#ifndef _BENCH_NAUDIO_H
+#define _BENCH_NAUDIO_H
+
+#include <Arduino.h>
+
+enum NOTE : uint8_t
+{
+    NRS, NC2, NCS2, ND2, NDS2, NE2, NF2, NFS2, NG2, NGS2, NA2, NAS2, NB2,
+    NC3, NCS3, ND3, NDS3, NE3, NF3, NFS3, NG3, NGS3, NA3, NAS3, NB3,
+    NC4, NCS4, ND4, NDS4, NE4, NF4, NFS4, NG4, NGS4, NA4, NAS4, NB4,
+    NC5, NCS5, ND5, NDS5, NE5, NF5, NFS5, NG5, NGS5, NA5, NAS5, NB5,
+    NC6, NCS6, ND6, NDS6, NE6, NF6, NFS6, NG6, NGS6, NA6, NAS6, NB6,
+    NC7, NCS7, ND7, NDS7, NE7, NF7, NFS7, NG7, NGS7, NA7, NAS7, NB7,
+    NC8, NCS8, ND8, NDS8, NE8, NF8, NFS8, NG8, NGS8, NA8, NAS8, NB8,
+    NS0, NS1, NS2, NS3, NS4, NS5, NS6, NS7, END, TEMPO,
+};
+
+enum DURATION : uint8_t
+{
+    DTS = 95, DS, DTE, DE, DTQ, DDE, DQ, DTH, DDQ, DH, DDH, DW, DBLIP,
+};
+
+class CAudio
+{
+    public:
+    
+    // Defined by CodecBench - EffectBench does not play music
+    void Play(uint8_t (*stream)(uint16_t, void*), void* data_A, void* data_B);
+};
+
+#endif
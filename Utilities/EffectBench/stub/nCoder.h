@@ -0,0 +1,4 @@
+// Host stand-in for nCoder - declarations only
+#ifndef _BENCH_NCODER_H
+#define _BENCH_NCODER_H
+#endif
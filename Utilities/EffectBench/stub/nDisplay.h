@@ -0,0 +1,17 @@
+// Host stand-in for nDisplay - types used by Config
+#ifndef _BENCH_NDISPLAY_H
+#define _BENCH_NDISPLAY_H
+
+#include <stdint.h>
+
+class CDisplay
+{
+    public:
+    
+    enum class Brightness : uint8_t
+    {
+        AUTO = 0, MIN = 0, L1, L2, L3, L4, L5, L6, L7, L8, MAX = L8,
+    };
+};
+
+#endif
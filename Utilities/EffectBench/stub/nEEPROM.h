@@ -0,0 +1,14 @@
+// Host stand-in for nEEPROM - declarations only
+#ifndef _BENCH_NEEPROM_H
+#define _BENCH_NEEPROM_H
+
+#include <stdint.h>
+
+class CEEPROM
+{
+    public:
+    
+    uint8_t Read(uint32_t address, uint8_t* data, uint32_t bytes, void (*callback)(const uint8_t) = nullptr);
+};
+
+#endif
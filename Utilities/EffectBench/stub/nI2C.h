@@ -0,0 +1,30 @@
+// Host stand-in for nI2C - bus is always idle
+#ifndef _BENCH_NI2C_H
+#define _BENCH_NI2C_H
+
+#include <stdint.h>
+
+class CI2C
+{
+    public:
+    
+    enum class Speed : uint8_t
+    {
+        SLOW,
+        FAST,
+    };
+    
+    struct Handle
+    {
+        uint8_t device;
+    };
+    
+    bool IsCommActive(void)
+    {
+        return false;
+    }
+};
+
+extern CI2C* nI2C;
+
+#endif
@@ -8,6 +8,7 @@ import array
 import random
 import json
 import argparse
+import copy
 import struct
 import usb.core
 import usb.util
@@ -35,6 +36,30 @@ STATUS_BUSY=2
 STATUS_RETRY=3
 STATUS_COMPLETE=4
 
+# Compressed note stream format - mirrors Firmware/PhotoniClock/NoteCodec.h
+COMPRESSED_FLAG=0x8000
+CODEC_PITCH_MIN=1
+CODEC_PITCH_MAX=84
+CODEC_TEMPO=94
+CODEC_DURATION=95
+CODEC_DURATION_COUNT=12
+CODEC_PAIR=108
+CODEC_DELTA_MIN=6
+CODEC_DELTA_COUNT=12
+CODEC_COPY=252
+CODEC_ESCAPE=254
+CODEC_WINDOW=32
+CODEC_COPY_MIN=3
+CODEC_COPY_MAX=CODEC_COPY_MIN + 15
+
+# Structural opcodes - mirrors Firmware/PhotoniClock/Music.h
+MUSIC_LOOP=108
+MUSIC_LOOP_END=109
+MUSIC_PHRASE=110
+PHRASE_SIZE=32
+PHRASE_DEPTH=2
+LOOP_COUNT_MAX=255
+
 crc_table = bytearray(256)
 ser = serial.Serial()
 
@@ -48,6 +73,8 @@ def main():
     parser.add_argument('-p', '--pagesize', type=int, help='Page size of EEPROM', default=32)
     parser.add_argument('-a', '--address_start', type=int, help='EEPROM memory address to write song values', default=0x100)
     parser.add_argument('-s', '--size_memory', type=int, help='Size of EEPROM in bytes', default=0x2000)
+    parser.add_argument('-c', '--compress', action='store_true', help='Store channels in compressed note stream format')
+    parser.add_argument('-l', '--loop', action='store_true', help='Replace repeated sections with loop opcodes')
     parser.add_argument('-v', '--verbosity', action='count', default=0, help='Each use increases verbosity level')
 
     args = parser.parse_args()
@@ -83,7 +110,7 @@ def main():
         remaining = args.size_memory - args.address_start
         warning_msg("Only " + str(percent) + "% memory available with given address_start: " + str(remaining) + " / " + str(args.size_memory))
     
-    data = process_data(data, args.address_start, args.size_memory)
+    data = process_data(data, args.address_start, args.size_memory, args.compress, args.loop)
 
     start_time = time.time()
 
@@ -122,13 +149,17 @@ def main():
     print("Completed in", "%.2f" % elapsed_time, "seconds\n")    
     time.sleep(1)
     
-def process_data(data, address_start, size_memory):
+def process_data(data, address_start, size_memory, compress=False, loop=False):
     list = []
     table = bytearray(address_start)
     values = bytearray()
     offset = address_start
     entries = 0
     sections = 0
+    raw_bytes = 0
+    
+    if compress and size_memory > COMPRESSED_FLAG:
+        error_msg_exit("Compressed offsets cannot address more than " + str(COMPRESSED_FLAG) + " bytes: " + str(size_memory))
     
     for index in range(0, len(data)):
         list.append(data[index]['Filename'])
@@ -154,9 +185,27 @@ def process_data(data, address_start, size_memory):
                 else:
                     error_msg_exit("Cannot find Channel_A")
             
+            raw_bytes += len(channel)
+            
+            if loop:
+                size = len(channel)
+                # Copies already cover sections within reach of the window
+                channel = loop_notes(channel, CODEC_WINDOW - CODEC_COPY_MIN - 1 if compress else 0)
+                if verbose > 0:
+                    print("Looped Channel_" + str(chr(c + ord('A'))), "from", size, "to", len(channel), "bytes")
+            
+            if compress:
+                size = len(channel)
+                channel = compress_notes(channel)
+                if verbose > 0:
+                    print("Compressed Channel_" + str(chr(c + ord('A'))), "from", size, "to", len(channel), "bytes")
+            
             # Table section
             # Get individual bytes
-            offset_bytes = struct.unpack("4B", struct.pack("I", offset))
+            if compress:
+                offset_bytes = struct.unpack("4B", struct.pack("I", offset | COMPRESSED_FLAG))
+            else:
+                offset_bytes = struct.unpack("4B", struct.pack("I", offset))
             if verbose > 1:
                 print("Channel_" + str(chr(c + ord('A'))), "table offset is:", offset)
             if verbose > 0:
@@ -232,7 +281,10 @@ def process_data(data, address_start, size_memory):
     table.extend(values)
     
     print("\nParsed", len(data), "songs (", sections, "sections )")
-    print("Table bytes:", address_start, "  Song bytes:", offset - address_start, "  Total bytes:", offset, "\n")
+    print("Table bytes:", address_start, "  Song bytes:", offset - address_start, "  Total bytes:", offset)
+    if compress or loop:
+        print("Packed", raw_bytes, "song bytes to", offset - address_start, "(", "%.1f" % (100.0 * (offset - address_start) / raw_bytes), "% )")
+    print("")
     return table
     
 def transmit_UART(data, pagesize):
@@ -525,6 +577,256 @@ def escape_array(array):
     array = copy[:]
     return array
     
+class NoteDecoder:
+    """Tracks decoder state of the firmware while encoding"""
+    
+    def __init__(self):
+        self.tokens = []
+        self.pitch = CODEC_PITCH_MIN
+        self.copy = 0
+        self.literal = True # Tempo byte
+        self.operand = True
+    
+    def push(self, byte):
+        if self.literal:
+            self.literal = False
+            self.emit(byte)
+        elif self.copy:
+            length = CODEC_COPY_MIN + ((self.copy & 0x1) << 3) + (byte & 0x7)
+            distance = (byte >> 3) + 1
+            self.copy = 0
+            for i in range(0, length):
+                self.emit(self.tokens[-distance])
+        elif byte < CODEC_PAIR:
+            self.emit(byte)
+        elif byte < CODEC_COPY:
+            delta, duration = divmod(byte - CODEC_PAIR, CODEC_DURATION_COUNT)
+            self.emit(self.pitch + delta - CODEC_DELTA_MIN)
+            self.emit(CODEC_DURATION + duration)
+        elif byte < CODEC_ESCAPE:
+            self.copy = byte # Wait for operand
+        else:
+            self.literal = True
+    
+    def emit(self, token):
+        # Operand of TEMPO is a value, not a pitch
+        if self.operand:
+            self.operand = False
+            self.literal = False # Operand may have been copied
+        elif token == CODEC_TEMPO:
+            self.operand = True
+            self.literal = True
+        elif token == MUSIC_LOOP:
+            self.operand = True
+        elif token >= CODEC_PITCH_MIN and token <= CODEC_PITCH_MAX:
+            self.pitch = token
+        self.tokens.append(token)
+
+def is_duration(token):
+    return token >= CODEC_DURATION and token < (CODEC_DURATION + CODEC_DURATION_COUNT)
+
+def encode_note(state, notes, index):
+    """Return bytes encoding the next token(s) without copying, and the token count"""
+    token = notes[index]
+    
+    if state.literal:
+        return [token], 1
+    
+    # Pitch then duration in one byte
+    if index + 1 < len(notes) and is_duration(notes[index + 1]) and token >= CODEC_PITCH_MIN and token <= CODEC_PITCH_MAX:
+        delta = token - state.pitch + CODEC_DELTA_MIN
+        if delta >= 0 and delta < CODEC_DELTA_COUNT:
+            return [CODEC_PAIR + (delta * CODEC_DURATION_COUNT) + (notes[index + 1] - CODEC_DURATION)], 2
+    
+    if token < CODEC_PAIR:
+        return [token], 1
+    
+    return [CODEC_ESCAPE, token], 1
+
+def encode_cost(state, notes, index, count):
+    """Bytes needed to encode count tokens without copying"""
+    state = copy.deepcopy(state)
+    cost = 0
+    end = index + count
+    while index < end:
+        code, size = encode_note(state, notes, index)
+        if index + size > end:
+            # Pair would straddle the end
+            return cost + 2
+        for byte in code:
+            state.push(byte)
+        cost += len(code)
+        index += size
+    return cost
+
+def compress_notes(notes):
+    """Compress a channel into the format decoded by CNoteDecoder"""
+    state = NoteDecoder()
+    output = bytearray()
+    index = 0
+    
+    while index < len(notes):
+        length = 0
+        distance = 0
+        
+        # Longest match in window - may overlap the tokens being copied
+        if not state.literal:
+            for d in range(1, min(CODEC_WINDOW, index) + 1):
+                l = 0
+                while l < CODEC_COPY_MAX and index + l < len(notes) and notes[index + l] == notes[index + l - d]:
+                    l += 1
+                if l > length:
+                    length = l
+                    distance = d
+        
+        if length >= CODEC_COPY_MIN and encode_cost(state, notes, index, length) > 2:
+            length_code = length - CODEC_COPY_MIN
+            code = [CODEC_COPY + (length_code >> 3), ((distance - 1) << 3) | (length_code & 0x7)]
+            size = length
+        else:
+            code, size = encode_note(state, notes, index)
+        
+        for byte in code:
+            state.push(byte)
+        output.extend(code)
+        index += size
+    
+    # Verify stream decodes to the original notes
+    if state.tokens != list(notes):
+        error_msg_exit("Compressed channel does not decode to original notes")
+    
+    return output
+
+def note_units(notes):
+    """Split notes into units that a section may not divide"""
+    units = []
+    index = 0
+    while index < len(notes):
+        size = 1
+        if notes[index] == CODEC_TEMPO or (index + 1 < len(notes) and notes[index] < CODEC_DURATION and is_duration(notes[index + 1])):
+            size = 2 # Tempo and value, or pitch and duration
+        units.append(tuple(notes[index:index + size]))
+        index += size
+    return units
+
+def flatten(units):
+    return [token for unit in units for token in unit]
+
+def loop_units(units, depth, body_min, outermost):
+    """Encode units with the most saving section at each unit"""
+    output = []
+    phrase = None
+    index = 0
+    
+    while index < len(units):
+        # Play previous outermost section again
+        if outermost and phrase and tuple(units[index:index + len(phrase)]) == phrase:
+            output.append(MUSIC_PHRASE)
+            index += len(phrase)
+            continue
+        
+        best = None
+        for length in range(1, ((len(units) - index) // 2) + 1):
+            body = units[index:index + length]
+            tokens = len(flatten(body))
+            # Cache holds body and LOOP_END
+            if tokens + 1 > PHRASE_SIZE:
+                break
+            if tokens < body_min:
+                continue
+            count = 1
+            while count <= LOOP_COUNT_MAX and units[index + (count * length):index + ((count + 1) * length)] == body:
+                count += 1
+            if count < 2:
+                continue
+            if depth > 1:
+                inner = loop_units(body, depth - 1, body_min, False)
+            else:
+                inner = flatten(body)
+            if len(inner) + 1 > PHRASE_SIZE:
+                continue
+            saving = (count * tokens) - (len(inner) + 3)
+            if best is None or saving > best[0]:
+                best = (saving, length, count, inner)
+        
+        if best and best[0] > 0:
+            saving, length, count, inner = best
+            output.extend([MUSIC_LOOP, count - 1] + inner + [MUSIC_LOOP_END])
+            phrase = tuple(units[index:index + length])
+            index += count * length
+        else:
+            output.extend(units[index])
+            index += 1
+    
+    return output
+
+def expand_notes(notes):
+    """Interpret loop opcodes as the firmware does - sections must fit its cache"""
+    output = []
+    cache = []
+    read = 0
+    frames = []
+    valid = False
+    passthrough = True # Tempo byte
+    operand = False
+    index = 0
+    
+    while True:
+        if read < len(cache):
+            token = cache[read]
+            read += 1
+        elif index < len(notes):
+            token = notes[index]
+            index += 1
+            if frames:
+                if len(cache) >= PHRASE_SIZE:
+                    # Firmware would stop caching and play the section once
+                    error_msg_exit("Looped section at byte " + str(index - 1) + " exceeds PHRASE_SIZE (" + str(PHRASE_SIZE) + " tokens)")
+                cache.append(token)
+                read = len(cache)
+        else:
+            return output
+        
+        if passthrough:
+            passthrough = False
+            output.append(token)
+        elif operand:
+            operand = False
+            if not frames:
+                cache = []
+                read = 0
+                valid = True
+            if len(frames) >= PHRASE_DEPTH:
+                error_msg_exit("Loops at byte " + str(index - 1) + " nest deeper than PHRASE_DEPTH (" + str(PHRASE_DEPTH) + ")")
+            frames.append([read, token])
+        elif token == CODEC_TEMPO:
+            passthrough = True
+            output.append(token)
+        elif token == MUSIC_LOOP:
+            operand = True
+        elif token == MUSIC_LOOP_END:
+            if frames[-1][1]:
+                frames[-1][1] -= 1
+                read = frames[-1][0]
+            else:
+                frames.pop()
+        elif token == MUSIC_PHRASE:
+            if valid and not frames:
+                frames.append([0, 0])
+                read = 0
+        else:
+            output.append(token)
+
+def loop_notes(notes, body_min=0):
+    """Replace repeated sections with loop opcodes - first byte is tempo"""
+    output = [notes[0]] + loop_units(note_units(notes[1:]), PHRASE_DEPTH, body_min, True)
+    
+    # Verify stream plays back the original notes
+    if expand_notes(output) != list(notes):
+        error_msg_exit("Looped channel does not play back original notes")
+    
+    return output
+
 def chunks(l, n):
     """Yield successive n-sized chunks from l."""
     for i in range(0, len(l), n):